@@ -1,1696 +1,5722 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>
-#include <stdbool.h>
-#include <ctype.h>
-#include <unistd.h> // For sleep function
-
-#define MAX_ROOMS 50
-#define MAX_PARKING 30
-#define MAX_GUESTS 100
-#define MAX_BOOKINGS 200
-#define MAX_STAFF 20
-#define MAX_NAME 50
-#define MAX_ID 15
-#define MAX_PASS 20
-#define FACILITIES 5
-#define MAX_SERVICES 10
-#define MAX_MAINTENANCE 20
-#define MAX_FEEDBACK 50
-#define MAX_INVENTORY 100
-#define MAX_EVENTS 30
-#define MAX_SCHEDULES 50
-#define MAX_BILLS 200
-#define DISCOUNT_THRESHOLD 1000
-#define LOYALTY_POINTS_RATE 10 // Points per $100 spent
-#define MAX_LOGS 1000
-
-// Date structure
-typedef struct
-{
-    int day, month, year;
-} Date;
-
-// Guest structure with linked list for history
-typedef struct Guest
-{
-    char id[MAX_ID];
-    char name[MAX_NAME];
-    char contact[15];
-    char email[50];
-    int loyalty_points;
-    char preferences[100];
-    struct Guest *next;
-} Guest;
-
-// Room structure
-typedef struct
-{
-    int room_no;
-    int type;   // 1: Standard, 2: Deluxe, 3: Suite
-    int status; // 0: Available, 1: Booked, 2: Maintenance
-    float price;
-    int floor;
-    int capacity;
-    char features[100];
-} Room;
-
-// Parking structure with linked list for waiting queue
-typedef struct ParkingSlot
-{
-    int slot_no;
-    int status; // 0: Available, 1: Occupied, 2: Reserved
-    char vehicle[20];
-    char guest_id[MAX_ID];
-    struct ParkingSlot *next;
-} ParkingSlot;
-
-// Facility structure
-typedef struct
-{
-    int facility_id;
-    char name[30];
-    int status;
-    float booking_fee;
-    int adjacent[FACILITIES];
-} Facility;
-
-// Booking structure with tree node
-typedef struct BookingNode
-{
-    char booking_id[10];
-    char guest_id[MAX_ID];
-    int room_no;
-    int parking_slot;
-    int facility_id;
-    Date check_in;
-    Date check_out;
-    float total;
-    int status; // 0: Upcoming, 1: Active, 2: Completed, 3: Cancelled
-    struct BookingNode *left;
-    struct BookingNode *right;
-} BookingNode;
-
-// User structure for staff/admin
-typedef struct User
-{
-    char id[MAX_ID];
-    char name[MAX_NAME];
-    char pass[MAX_PASS];
-    char role[10]; // "staff" or "admin"
-    char department[20];
-    int access_level;
-} User;
-
-// Room service structure
-typedef struct
-{
-    int service_id;
-    int room_no;
-    char items[100];
-    char time[10];
-    char status[20]; // "Pending", "In Progress", "Completed"
-    float charge;
-} RoomService;
-
-// Maintenance request structure
-typedef struct
-{
-    int request_id;
-    int room_no;
-    char issue[100];
-    char priority[10]; // "Low", "Medium", "High"
-    char status[20];   // "Open", "In Progress", "Resolved"
-    Date report_date;
-} MaintenanceRequest;
-
-// Feedback structure
-typedef struct
-{
-    int feedback_id;
-    char guest_id[MAX_ID];
-    char comment[200];
-    int rating; // 1-5
-    Date date;
-} Feedback;
-
-// Inventory item structure
-typedef struct
-{
-    int item_id;
-    char name[50];
-    int quantity;
-    float unit_price;
-    char category[30]; // "Food", "Housekeeping", "Maintenance", etc.
-    int reorder_level;
-} InventoryItem;
-
-// Event structure
-typedef struct
-{
-    int event_id;
-    char name[50];
-    Date date;
-    char time[10];
-    int facility_id;
-    char organizer[MAX_NAME];
-    int capacity;
-    float cost;
-    int status; // 0: Planned, 1: Ongoing, 2: Completed
-} Event;
-
-// Staff schedule structure
-typedef struct
-{
-    int schedule_id;
-    char staff_id[MAX_ID];
-    Date date;
-    char shift[20]; // "Morning", "Evening", "Night"
-    char task[50];
-} StaffSchedule;
-
-// Billing structure
-typedef struct
-{
-    int bill_id;
-    char guest_id[MAX_ID];
-    char booking_id[10];
-    float room_charges;
-    float service_charges;
-    float facility_charges;
-    float taxes;
-    float total;
-    int status; // 0: Unpaid, 1: Paid
-    Date issue_date;
-} Bill;
-
-// System log structure
-typedef struct
-{
-    int log_id;
-    char user_id[MAX_ID];
-    char action[100];
-    Date date;
-    char time[10];
-} SystemLog;
-
-// Global variables
-Room rooms[MAX_ROOMS];
-ParkingSlot *parking_slots = NULL;
-ParkingSlot *parking_waitlist = NULL;
-Facility facilities[FACILITIES];
-Guest *guest_list = NULL;
-BookingNode *booking_tree = NULL;
-User users[MAX_STAFF + 1];
-RoomService services[MAX_SERVICES];
-MaintenanceRequest maintenance[MAX_MAINTENANCE];
-Feedback feedbacks[MAX_FEEDBACK];
-InventoryItem inventory[MAX_INVENTORY];
-Event events[MAX_EVENTS];
-StaffSchedule schedules[MAX_SCHEDULES];
-Bill bills[MAX_BILLS];
-SystemLog logs[MAX_LOGS];
-int guest_count = 0, booking_count = 0, user_count = 0;
-int service_count = 0, maintenance_count = 0, feedback_count = 0;
-int inventory_count = 0, event_count = 0, schedule_count = 0, bill_count = 0;
-int log_count = 0;
-float total_revenue = 0;
-
-// ======================== UTILITY FUNCTIONS ========================
-
-// Generate random ID
-void generate_id(char *id, int length)
-{
-    int i;
-    static const char alphanum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    for (i = 0; i < length; ++i)
-    {
-        id[i] = alphanum[rand() % (sizeof(alphanum) - 1)];
-    }
-    id[length] = '\0';
-}
-
-// Validate date
-int is_valid_date(Date d)
-{
-    if (d.year < 2023 || d.year > 2100)
-        return 0;
-    if (d.month < 1 || d.month > 12)
-        return 0;
-    if (d.day < 1 || d.day > 31)
-        return 0;
-    if ((d.month == 4 || d.month == 6 || d.month == 9 || d.month == 11) && d.day > 30)
-        return 0;
-    if (d.month == 2)
-    {
-        int leap = (d.year % 4 == 0 && (d.year % 100 != 0 || d.year % 400 == 0));
-        if (d.day > (28 + leap))
-            return 0;
-    }
-    return 1;
-}
-
-// Compare dates
-int compare_dates(Date d1, Date d2)
-{
-    if (d1.year != d2.year)
-        return d1.year - d2.year;
-    if (d1.month != d2.month)
-        return d1.month - d2.month;
-    return d1.day - d2.day;
-}
-
-// Calculate days between dates
-int date_diff(Date d1, Date d2)
-{
-    struct tm tm1 = {0, 0, 0, d1.day, d1.month - 1, d1.year - 1900};
-    struct tm tm2 = {0, 0, 0, d2.day, d2.month - 1, d2.year - 1900};
-    time_t t1 = mktime(&tm1);
-    time_t t2 = mktime(&tm2);
-    return difftime(t2, t1) / (60 * 60 * 24);
-}
-
-// Get current date
-Date get_current_date()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    Date current = {tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900};
-    return current;
-}
-
-// Get current time
-void get_current_time(char *time_str)
-{
-    time_t now = time(NULL);
-    struct tm *tm = localtime(&now);
-    strftime(time_str, 10, "%H:%M", tm);
-}
-
-// Log system activity
-void log_activity(char *user_id, char *action)
-{
-    if (log_count >= MAX_LOGS)
-        return;
-    logs[log_count].log_id = log_count + 1;
-    strcpy(logs[log_count].user_id, user_id);
-    strcpy(logs[log_count].action, action);
-    logs[log_count].date = get_current_date();
-    get_current_time(logs[log_count].time);
-    log_count++;
-}
-
-// ======================== LINKED LIST OPERATIONS ========================
-
-// Add guest
-void add_guest_to_list(Guest **head, Guest new_guest)
-{
-    Guest *new_node = (Guest *)malloc(sizeof(Guest));
-    strcpy(new_node->id, new_guest.id);
-    strcpy(new_node->name, new_guest.name);
-    strcpy(new_node->contact, new_guest.contact);
-    strcpy(new_node->email, new_guest.email);
-    new_node->loyalty_points = 0;
-    strcpy(new_node->preferences, "");
-    new_node->next = *head;
-    *head = new_node;
-    guest_count++;
-}
-
-// Find guest
-Guest *find_guest_in_list(Guest *head, char *id)
-{
-    Guest *current = head;
-    while (current != NULL)
-    {
-        if (strcmp(current->id, id) == 0)
-            return current;
-        current = current->next;
-    }
-    return NULL;
-}
-
-// Add parking slot
-void add_parking_slot(ParkingSlot **head, int slot_no)
-{
-    ParkingSlot *new_node = (ParkingSlot *)malloc(sizeof(ParkingSlot));
-    new_node->slot_no = slot_no;
-    new_node->status = 0;
-    strcpy(new_node->vehicle, "");
-    strcpy(new_node->guest_id, "");
-    new_node->next = *head;
-    *head = new_node;
-}
-
-// Add to parking waitlist
-void add_to_waitlist(ParkingSlot **head, char *vehicle, char *guest_id)
-{
-    ParkingSlot *new_node = (ParkingSlot *)malloc(sizeof(ParkingSlot));
-    new_node->slot_no = -1;
-    new_node->status = 1;
-    strcpy(new_node->vehicle, vehicle);
-    strcpy(new_node->guest_id, guest_id);
-    new_node->next = *head;
-    *head = new_node;
-}
-
-// Remove from waitlist
-ParkingSlot *remove_from_waitlist(ParkingSlot **head)
-{
-    if (*head == NULL)
-        return NULL;
-    ParkingSlot *temp = *head;
-    *head = (*head)->next;
-    return temp;
-}
-
-// ======================== BINARY TREE OPERATIONS ========================
-
-// Create new booking node
-BookingNode *new_booking_node(char *guest_id, int room_no, int parking_slot,
-                              int facility_id, Date ci, Date co, float total)
-{
-    BookingNode *node = (BookingNode *)malloc(sizeof(BookingNode));
-    generate_id(node->booking_id, 6);
-    strcpy(node->guest_id, guest_id);
-    node->room_no = room_no;
-    node->parking_slot = parking_slot;
-    node->facility_id = facility_id;
-    node->check_in = ci;
-    node->check_out = co;
-    node->total = total;
-    node->status = 0;
-    node->left = node->right = NULL;
-    booking_count++;
-    return node;
-}
-
-// Insert booking
-BookingNode *insert_booking(BookingNode *node, BookingNode *new_node)
-{
-    if (node == NULL)
-        return new_node;
-    int date_compare = compare_dates(new_node->check_in, node->check_in);
-    if (date_compare < 0)
-    {
-        node->left = insert_booking(node->left, new_node);
-    }
-    else
-    {
-        node->right = insert_booking(node->right, new_node);
-    }
-    return node;
-}
-
-// Search bookings by guest ID
-void search_bookings_by_guest(BookingNode *root, char *guest_id)
-{
-    if (root != NULL)
-    {
-        search_bookings_by_guest(root->left, guest_id);
-        if (strcmp(root->guest_id, guest_id) == 0)
-        {
-            char *status_str[] = {"Upcoming", "Active", "Completed", "Cancelled"};
-            printf("Booking ID: %s, Room %d, Check-in: %02d/%02d/%d, Status: %s\n",
-                   root->booking_id, root->room_no, root->check_in.day,
-                   root->check_in.month, root->check_in.year, status_str[root->status]);
-        }
-        search_bookings_by_guest(root->right, guest_id);
-    }
-}
-
-// Find booking
-BookingNode *find_booking(BookingNode *root, char *booking_id)
-{
-    if (root == NULL)
-        return NULL;
-    if (strcmp(root->booking_id, booking_id) == 0)
-        return root;
-    BookingNode *left = find_booking(root->left, booking_id);
-    if (left != NULL)
-        return left;
-    return find_booking(root->right, booking_id);
-}
-
-// Update booking status
-void update_booking_status(BookingNode *root, Date current)
-{
-    if (root != NULL)
-    {
-        update_booking_status(root->left, current);
-        if (root->status == 0 && compare_dates(current, root->check_in) >= 0)
-        {
-            root->status = 1;
-        }
-        if (root->status == 1 && compare_dates(current, root->check_out) >= 0)
-        {
-            root->status = 2;
-        }
-        update_booking_status(root->right, current);
-    }
-}
-
-// ======================== GRAPH OPERATIONS ========================
-
-// Initialize facility graph
-void init_facility_graph()
-{
-    facilities[0].adjacent[1] = 1;
-    facilities[0].adjacent[2] = 1;
-    facilities[1].adjacent[0] = 1;
-    facilities[1].adjacent[3] = 1;
-    facilities[2].adjacent[0] = 1;
-    facilities[2].adjacent[3] = 1;
-    facilities[3].adjacent[1] = 1;
-    facilities[3].adjacent[2] = 1;
-    facilities[3].adjacent[4] = 1;
-    facilities[4].adjacent[3] = 1;
-}
-
-// Find nearby facilities
-void find_nearby_facilities(int facility_id)
-{
-    int i;
-    if (facility_id < 1 || facility_id > FACILITIES)
-    {
-        printf("Invalid facility ID!\n");
-        return;
-    }
-    printf("Facilities near %s:\n", facilities[facility_id - 1].name);
-    for (i = 0; i < FACILITIES; i++)
-    {
-        if (facilities[facility_id - 1].adjacent[i] == 1)
-        {
-            printf("- %s ($%.2f)\n", facilities[i].name, facilities[i].booking_fee);
-        }
-    }
-}
-
-// ======================== CORE SYSTEM FUNCTIONS ========================
-
-void init_system()
-{
-    srand(time(0));
-    int i;
-    // Initialize rooms
-    for (i = 0; i < MAX_ROOMS; i++)
-    {
-        rooms[i].room_no = i + 1;
-        rooms[i].type = (i % 3) + 1;
-        rooms[i].status = 0;
-        rooms[i].floor = (i / 10) + 1;
-        rooms[i].capacity = (rooms[i].type == 1) ? 2 : (rooms[i].type == 2) ? 4
-                                                                            : 6;
-        if (rooms[i].type == 1)
-        {
-            rooms[i].price = 100 + (rand() % 50);
-            strcpy(rooms[i].features, "TV, WiFi, AC");
-        }
-        else if (rooms[i].type == 2)
-        {
-            rooms[i].price = 200 + (rand() % 100);
-            strcpy(rooms[i].features, "TV, WiFi, AC, Mini-bar, Balcony");
-        }
-        else
-        {
-            rooms[i].price = 500 + (rand() % 200);
-            strcpy(rooms[i].features, "TV, WiFi, AC, Mini-bar, Jacuzzi, Living area");
-        }
-    }
-
-    // Initialize parking
-    for (i = MAX_PARKING; i >= 1; i--)
-    {
-        add_parking_slot(&parking_slots, i);
-    }
-
-    // Initialize facilities
-    int j;
-    char *fac_names[] = {"Gym", "Pool", "Spa", "Restaurant", "Conference Room"};
-    float fac_fees[] = {10.0, 5.0, 50.0, 0.0, 100.0};
-    for (i = 0; i < FACILITIES; i++)
-    {
-        facilities[i].facility_id = i + 1;
-        strcpy(facilities[i].name, fac_names[i]);
-        facilities[i].status = 0;
-        facilities[i].booking_fee = fac_fees[i];
-        for (j = 0; j < FACILITIES; j++)
-        {
-            facilities[i].adjacent[j] = 0;
-        }
-    }
-    init_facility_graph();
-
-    // Initialize users
-    strcpy(users[0].id, "admin");
-    strcpy(users[0].name, "Administrator");
-    strcpy(users[0].pass, "admin123");
-    strcpy(users[0].role, "admin");
-    strcpy(users[0].department, "Management");
-    users[0].access_level = 5;
-    user_count = 1;
-
-    // Initialize sample inventory
-    char *inv_names[] = {"Towels", "Bed Sheets", "Shampoo", "Coffee", "Light Bulbs"};
-    char *inv_cats[] = {"Housekeeping", "Housekeeping", "Housekeeping", "Food", "Maintenance"};
-    float inv_prices[] = {5.0, 10.0, 2.0, 3.0, 4.0};
-    int inv_quants[] = {100, 50, 200, 300, 150};
-    int inv_reorder[] = {20, 10, 50, 50, 30};
-    for (i = 0; i < 5; i++)
-    {
-        inventory[i].item_id = i + 1;
-        strcpy(inventory[i].name, inv_names[i]);
-        strcpy(inventory[i].category, inv_cats[i]);
-        inventory[i].quantity = inv_quants[i];
-        inventory[i].unit_price = inv_prices[i];
-        inventory[i].reorder_level = inv_reorder[i];
-        inventory_count++;
-    }
-}
-
-void add_guest(char *user_id)
-{
-    if (guest_count >= MAX_GUESTS)
-    {
-        printf("Max guests reached!\n");
-        return;
-    }
-    Guest new_guest;
-    printf("Enter guest ID: ");
-    scanf("%s", new_guest.id);
-    if (find_guest_in_list(guest_list, new_guest.id) != NULL)
-    {
-        printf("Guest ID exists!\n");
-        return;
-    }
-    printf("Enter name: ");
-    scanf(" %[^\n]", new_guest.name);
-    printf("Enter contact: ");
-    scanf("%s", new_guest.contact);
-    printf("Enter email: ");
-    scanf("%s", new_guest.email);
-    printf("Enter preferences (optional): ");
-    scanf(" %[^\n]", new_guest.preferences);
-    add_guest_to_list(&guest_list, new_guest);
-    printf("Guest added successfully!\n");
-    char log_msg[100];
-    sprintf(log_msg, "Added guest %s", new_guest.id);
-    log_activity(user_id, log_msg);
-}
-
-void view_guest_details()
-{
-    char id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", id);
-    Guest *guest = find_guest_in_list(guest_list, id);
-    if (guest == NULL)
-    {
-        printf("Guest not found!\n");
-        return;
-    }
-    printf("\n=== GUEST DETAILS ===\n");
-    printf("ID: %s\nName: %s\nContact: %s\nEmail: %s\n",
-           guest->id, guest->name, guest->contact, guest->email);
-    printf("Preferences: %s\nLoyalty Points: %d\n",
-           guest->preferences, guest->loyalty_points);
-    printf("\nBooking History:\n");
-    search_bookings_by_guest(booking_tree, id);
-}
-
-void book_room(char *user_id)
-{
-    if (guest_count == 0)
-    {
-        printf("No guests registered!\n");
-        return;
-    }
-    char guest_id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", guest_id);
-    Guest *guest = find_guest_in_list(guest_list, guest_id);
-    if (guest == NULL)
-    {
-        printf("Guest not found!\n");
-        return;
-    }
-    int i;
-    printf("\nAvailable Rooms:\n");
-    printf("Room No\tType\tFloor\tCapacity\tPrice\tFeatures\n");
-    for (i = 0; i < MAX_ROOMS; i++)
-    {
-        if (rooms[i].status == 0)
-        {
-            char *type = (rooms[i].type == 1) ? "Standard" : (rooms[i].type == 2) ? "Deluxe"
-                                                                                  : "Suite";
-            printf("%d\t%s\t%d\t%d\t\t$%.2f\t%s\n",
-                   rooms[i].room_no, type, rooms[i].floor, rooms[i].capacity,
-                   rooms[i].price, rooms[i].features);
-        }
-    }
-    int room_no;
-    printf("\nEnter room number: ");
-    scanf("%d", &room_no);
-    if (room_no < 1 || room_no > MAX_ROOMS || rooms[room_no - 1].status != 0)
-    {
-        printf("Invalid or unavailable room!\n");
-        return;
-    }
-    Date ci, co;
-    printf("Enter check-in date (dd mm yyyy): ");
-    scanf("%d %d %d", &ci.day, &ci.month, &ci.year);
-    printf("Enter check-out date (dd mm yyyy): ");
-    scanf("%d %d %d", &co.day, &co.month, &co.year);
-    if (!is_valid_date(ci) || !is_valid_date(co) || date_diff(ci, co) <= 0)
-    {
-        printf("Invalid dates!\n");
-        return;
-    }
-    float base_price = rooms[room_no - 1].price * date_diff(ci, co);
-    float discount = (guest->loyalty_points >= DISCOUNT_THRESHOLD) ? base_price * 0.1 : 0;
-    float total = base_price - discount;
-    if (discount > 0)
-    {
-        printf("Applied 10%% discount ($%.2f)!\n", discount);
-        guest->loyalty_points -= DISCOUNT_THRESHOLD;
-    }
-    rooms[room_no - 1].status = 1;
-    int points_earned = (int)(total / 100) * LOYALTY_POINTS_RATE;
-    guest->loyalty_points += points_earned;
-    BookingNode *new_booking = new_booking_node(guest_id, room_no, -1, -1, ci, co, total);
-    booking_tree = insert_booking(booking_tree, new_booking);
-    total_revenue += total;
-    printf("\n=== BOOKING CONFIRMED ===\n");
-    printf("Booking ID: %s\nRoom: %d\nCheck-in: %02d/%02d/%d\nCheck-out: %02d/%02d/%d\nTotal: $%.2f\n",
-           new_booking->booking_id, room_no, ci.day, ci.month, ci.year, co.day, co.month, co.year, total);
-    printf("Earned %d loyalty points. Total: %d\n", points_earned, guest->loyalty_points);
-    char log_msg[100];
-    sprintf(log_msg, "Booked room %d for guest %s", room_no, guest_id);
-    log_activity(user_id, log_msg);
-}
-
-void assign_parking(char *user_id)
-{
-    char guest_id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", guest_id);
-    ParkingSlot *slot = parking_slots;
-    while (slot != NULL)
-    {
-        if (strcmp(slot->guest_id, guest_id) == 0)
-        {
-            printf("Guest already has slot %d!\n", slot->slot_no);
-            return;
-        }
-        slot = slot->next;
-    }
-    slot = parking_slots;
-    ParkingSlot *prev = NULL;
-    while (slot != NULL)
-    {
-        if (slot->status == 0)
-            break;
-        prev = slot;
-        slot = slot->next;
-    }
-    char vehicle[20];
-    printf("Enter vehicle type: ");
-    scanf(" %[^\n]", vehicle);
-    if (slot != NULL)
-    {
-        slot->status = 1;
-        strcpy(slot->vehicle, vehicle);
-        strcpy(slot->guest_id, guest_id);
-        BookingNode *booking = booking_tree;
-        while (booking != NULL)
-        {
-            if (strcmp(booking->guest_id, guest_id) == 0 && booking->status < 2)
-            {
-                booking->parking_slot = slot->slot_no;
-                break;
-            }
-            booking = booking->left;
-        }
-        printf("Assigned slot %d for %s\n", slot->slot_no, vehicle);
-        char log_msg[100];
-        sprintf(log_msg, "Assigned parking slot %d to guest %s", slot->slot_no, guest_id);
-        log_activity(user_id, log_msg);
-    }
-    else
-    {
-        add_to_waitlist(&parking_waitlist, vehicle, guest_id);
-        printf("No parking available. Added to waitlist.\n");
-        char log_msg[100];
-        sprintf(log_msg, "Added guest %s to parking waitlist", guest_id);
-        log_activity(user_id, log_msg);
-    }
-}
-
-void process_waitlist(char *user_id)
-{
-    ParkingSlot *waiting = parking_waitlist;
-    if (waiting == NULL)
-    {
-        printf("No vehicles in waitlist.\n");
-        return;
-    }
-    ParkingSlot *slot = parking_slots;
-    while (slot != NULL && waiting != NULL)
-    {
-        if (slot->status == 0)
-        {
-            slot->status = 1;
-            strcpy(slot->vehicle, waiting->vehicle);
-            strcpy(slot->guest_id, waiting->guest_id);
-            printf("Assigned slot %d to %s\n", slot->slot_no, waiting->vehicle);
-            BookingNode *booking = booking_tree;
-            while (booking != NULL)
-            {
-                if (strcmp(booking->guest_id, waiting->guest_id) == 0 && booking->status < 2)
-                {
-                    booking->parking_slot = slot->slot_no;
-                    break;
-                }
-                booking = booking->left;
-            }
-            ParkingSlot *temp = waiting;
-            waiting = waiting->next;
-            free(temp);
-            parking_waitlist = waiting;
-            char log_msg[100];
-            sprintf(log_msg, "Assigned parking slot %d from waitlist to guest %s",
-                    slot->slot_no, slot->guest_id);
-            log_activity(user_id, log_msg);
-        }
-        slot = slot->next;
-    }
-}
-
-void book_facility(char *user_id)
-{
-    int i;
-    printf("\nAvailable Facilities:\n");
-    printf("ID\tName\t\tFee\tStatus\n");
-    for (i = 0; i < FACILITIES; i++)
-    {
-        printf("%d\t%s\t$%.2f\t%s\n", facilities[i].facility_id, facilities[i].name,
-               facilities[i].booking_fee, facilities[i].status ? "Booked" : "Available");
-    }
-    int facility_id;
-    printf("\nEnter facility ID: ");
-    scanf("%d", &facility_id);
-    if (facility_id < 1 || facility_id > FACILITIES || facilities[facility_id - 1].status != 0)
-    {
-        printf("Invalid or booked facility!\n");
-        return;
-    }
-    char guest_id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", guest_id);
-    Guest *guest = find_guest_in_list(guest_list, guest_id);
-    if (guest == NULL)
-    {
-        printf("Guest not found!\n");
-        return;
-    }
-    Date date;
-    printf("Enter booking date (dd mm yyyy): ");
-    scanf("%d %d %d", &date.day, &date.month, &date.year);
-    if (!is_valid_date(date))
-    {
-        printf("Invalid date!\n");
-        return;
-    }
-    float fee = facilities[facility_id - 1].booking_fee;
-    if (guest->loyalty_points >= DISCOUNT_THRESHOLD && fee > 0)
-    {
-        fee *= 0.5;
-        printf("Applied 50%% discount! New fee: $%.2f\n", fee);
-        guest->loyalty_points -= DISCOUNT_THRESHOLD;
-    }
-    facilities[facility_id - 1].status = 1;
-    BookingNode *new_booking = new_booking_node(guest_id, -1, -1, facility_id, date, date, fee);
-    booking_tree = insert_booking(booking_tree, new_booking);
-    int points_earned = (facility_id == 3) ? 0 : 5;
-    guest->loyalty_points += points_earned;
-    total_revenue += fee;
-    printf("\n=== FACILITY BOOKING CONFIRMED ===\n");
-    printf("Booking ID: %s\nFacility: %s\nDate: %02d/%02d/%d\nFee: $%.2f\n",
-           new_booking->booking_id, facilities[facility_id - 1].name,
-           date.day, date.month, date.year, fee);
-    printf("Earned %d loyalty points. Total: %d\n", points_earned, guest->loyalty_points);
-    find_nearby_facilities(facility_id);
-    char log_msg[100];
-    sprintf(log_msg, "Booked facility %s for guest %s", facilities[facility_id - 1].name, guest_id);
-    log_activity(user_id, log_msg);
-}
-
-void order_room_service(char *user_id)
-{
-    if (service_count >= MAX_SERVICES)
-    {
-        printf("Max service orders reached!\n");
-        return;
-    }
-    int room_no;
-    printf("Enter room number: ");
-    scanf("%d", &room_no);
-    if (room_no < 1 || room_no > MAX_ROOMS)
-    {
-        printf("Invalid room number!\n");
-        return;
-    }
-    int occupied = 0;
-    BookingNode *booking = booking_tree;
-    while (booking != NULL)
-    {
-        if (booking->room_no == room_no && booking->status == 1)
-        {
-            occupied = 1;
-            break;
-        }
-        booking = booking->left;
-    }
-    if (!occupied)
-    {
-        printf("Room not occupied!\n");
-        return;
-    }
-    printf("Available items:\n");
-    printf("1. Breakfast Set ($15.00)\n2. Lunch Set ($20.00)\n3. Dinner Set ($25.00)\n");
-    printf("4. Snack Pack ($10.00)\n5. Beverage ($5.00)\n");
-    int choice;
-    printf("Enter item number: ");
-    scanf("%d", &choice);
-    if (choice < 1 || choice > 5)
-    {
-        printf("Invalid choice!\n");
-        return;
-    }
-    char *items[] = {"Breakfast Set", "Lunch Set", "Dinner Set", "Snack Pack", "Beverage"};
-    float prices[] = {15.0, 20.0, 25.0, 10.0, 5.0};
-    char time_str[10];
-    get_current_time(time_str);
-    services[service_count].service_id = service_count + 1;
-    services[service_count].room_no = room_no;
-    strcpy(services[service_count].items, items[choice - 1]);
-    strcpy(services[service_count].time, time_str);
-    strcpy(services[service_count].status, "Pending");
-    services[service_count].charge = prices[choice - 1];
-    printf("\n=== SERVICE ORDER CREATED ===\n");
-    printf("Order ID: %d\nRoom: %d\nItems: %s\nTime: %s\nCharge: $%.2f\n",
-           services[service_count].service_id, room_no, items[choice - 1], time_str, prices[choice - 1]);
-    service_count++;
-    char log_msg[100];
-    sprintf(log_msg, "Ordered room service %s for room %d", items[choice - 1], room_no);
-    log_activity(user_id, log_msg);
-}
-
-void update_service_status(char *user_id)
-{
-    int i;
-    if (service_count == 0)
-    {
-        printf("No service orders!\n");
-        return;
-    }
-    printf("Current service orders:\n");
-    printf("ID\tRoom\tItems\t\tTime\tStatus\tCharge\n");
-    for (i = 0; i < service_count; i++)
-    {
-        printf("%d\t%d\t%s\t%s\t%s\t$%.2f\n",
-               services[i].service_id, services[i].room_no, services[i].items,
-               services[i].time, services[i].status, services[i].charge);
-    }
-    int id, choice;
-    printf("Enter service ID: ");
-    scanf("%d", &id);
-    int found = 0;
-    for (i = 0; i < service_count; i++)
-    {
-        if (services[i].service_id == id)
-        {
-            found = 1;
-            printf("\nCurrent status: %s\n1. Mark as In Progress\n2. Mark as Completed\n",
-                   services[i].status);
-            printf("Enter choice: ");
-            scanf("%d", &choice);
-            if (choice == 1)
-            {
-                strcpy(services[i].status, "In Progress");
-                printf("Status updated to In Progress\n");
-            }
-            else if (choice == 2)
-            {
-                strcpy(services[i].status, "Completed");
-                BookingNode *booking = booking_tree;
-                while (booking != NULL)
-                {
-                    if (booking->room_no == services[i].room_no && booking->status == 1)
-                    {
-                        Guest *guest = find_guest_in_list(guest_list, booking->guest_id);
-                        if (guest != NULL)
-                            guest->loyalty_points += 1;
-                        break;
-                    }
-                    booking = booking->left;
-                }
-                printf("Status updated to Completed. Guest earned 1 point.\n");
-            }
-            else
-            {
-                printf("Invalid choice!\n");
-            }
-            char log_msg[100];
-            sprintf(log_msg, "Updated service order %d status to %s", id,
-                    choice == 1 ? "In Progress" : "Completed");
-            log_activity(user_id, log_msg);
-            break;
-        }
-    }
-    if (!found)
-        printf("Service ID not found!\n");
-}
-
-void report_maintenance(char *user_id)
-{
-    if (maintenance_count >= MAX_MAINTENANCE)
-    {
-        printf("Max maintenance requests reached!\n");
-        return;
-    }
-    int room_no;
-    printf("Enter room number: ");
-    scanf("%d", &room_no);
-    if (room_no < 1 || room_no > MAX_ROOMS)
-    {
-        printf("Invalid room number!\n");
-        return;
-    }
-    printf("Issue types:\n1. Electrical\n2. Plumbing\n3. HVAC\n4. Furniture\n5. Other\n");
-    int issue_type;
-    printf("Enter issue type: ");
-    scanf("%d", &issue_type);
-    if (issue_type < 1 || issue_type > 5)
-    {
-        printf("Invalid issue type!\n");
-        return;
-    }
-    printf("Priority:\n1. Low\n2. Medium\n3. High\n");
-    int priority;
-    printf("Enter priority: ");
-    scanf("%d", &priority);
-    if (priority < 1 || priority > 3)
-    {
-        printf("Invalid priority!\n");
-        return;
-    }
-    char description[100];
-    printf("Enter description: ");
-    scanf(" %[^\n]", description);
-    char *issues[] = {"Electrical", "Plumbing", "HVAC", "Furniture", "Other"};
-    char *priorities[] = {"Low", "Medium", "High"};
-    maintenance[maintenance_count].request_id = maintenance_count + 1;
-    maintenance[maintenance_count].room_no = room_no;
-    strcpy(maintenance[maintenance_count].issue, issues[issue_type - 1]);
-    strcat(maintenance[maintenance_count].issue, ": ");
-    strcat(maintenance[maintenance_count].issue, description);
-    strcpy(maintenance[maintenance_count].priority, priorities[priority - 1]);
-    strcpy(maintenance[maintenance_count].status, "Open");
-    maintenance[maintenance_count].report_date = get_current_date();
-    rooms[room_no - 1].status = 2;
-    printf("\n=== MAINTENANCE REQUEST CREATED ===\n");
-    printf("Request ID: %d\nRoom: %d\nIssue: %s\nPriority: %s\nDate: %02d/%02d/%d\n",
-           maintenance[maintenance_count].request_id, room_no,
-           maintenance[maintenance_count].issue, priorities[priority - 1],
-           maintenance[maintenance_count].report_date.day,
-           maintenance[maintenance_count].report_date.month,
-           maintenance[maintenance_count].report_date.year);
-    maintenance_count++;
-    char log_msg[100];
-    sprintf(log_msg, "Reported maintenance issue for room %d", room_no);
-    log_activity(user_id, log_msg);
-}
-
-void update_maintenance_status(char *user_id)
-{
-    int i;
-    if (maintenance_count == 0)
-    {
-        printf("No maintenance requests!\n");
-        return;
-    }
-    printf("Maintenance Requests:\n");
-    printf("ID\tRoom\tIssue\tPriority\tStatus\tDate\n");
-    for (i = 0; i < maintenance_count; i++)
-    {
-        printf("%d\t%d\t%s\t%s\t%s\t%02d/%02d/%d\n",
-               maintenance[i].request_id, maintenance[i].room_no, maintenance[i].issue,
-               maintenance[i].priority, maintenance[i].status,
-               maintenance[i].report_date.day, maintenance[i].report_date.month,
-               maintenance[i].report_date.year);
-    }
-    int id, choice;
-    printf("Enter request ID: ");
-    scanf("%d", &id);
-    int found = 0;
-    for (i = 0; i < maintenance_count; i++)
-    {
-        if (maintenance[i].request_id == id)
-        {
-            found = 1;
-            printf("\nCurrent status: %s\n1. Mark as In Progress\n2. Mark as Resolved\n",
-                   maintenance[i].status);
-            printf("Enter choice: ");
-            scanf("%d", &choice);
-            if (choice == 1)
-            {
-                strcpy(maintenance[i].status, "In Progress");
-                printf("Status updated to In Progress\n");
-            }
-            else if (choice == 2)
-            {
-                strcpy(maintenance[i].status, "Resolved");
-                rooms[maintenance[i].room_no - 1].status = 0;
-                printf("Status updated to Resolved. Room available.\n");
-            }
-            else
-            {
-                printf("Invalid choice!\n");
-            }
-            char log_msg[100];
-            sprintf(log_msg, "Updated maintenance request %d status to %s", id,
-                    choice == 1 ? "In Progress" : "Resolved");
-            log_activity(user_id, log_msg);
-            break;
-        }
-    }
-    if (!found)
-        printf("Request ID not found!\n");
-}
-
-void submit_feedback(char *user_id)
-{
-    if (feedback_count >= MAX_FEEDBACK)
-    {
-        printf("Max feedback reached!\n");
-        return;
-    }
-    char guest_id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", guest_id);
-    if (find_guest_in_list(guest_list, guest_id) == NULL)
-    {
-        printf("Guest not found!\n");
-        return;
-    }
-    char comment[200];
-    int rating;
-    printf("Enter comment: ");
-    scanf(" %[^\n]", comment);
-    printf("Enter rating (1-5): ");
-    scanf("%d", &rating);
-    if (rating < 1 || rating > 5)
-    {
-        printf("Invalid rating!\n");
-        return;
-    }
-    feedbacks[feedback_count].feedback_id = feedback_count + 1;
-    strcpy(feedbacks[feedback_count].guest_id, guest_id);
-    strcpy(feedbacks[feedback_count].comment, comment);
-    feedbacks[feedback_count].rating = rating;
-    feedbacks[feedback_count].date = get_current_date();
-    feedback_count++;
-    printf("Feedback submitted successfully!\n");
-    char log_msg[100];
-    sprintf(log_msg, "Guest %s submitted feedback with rating %d", guest_id, rating);
-    log_activity(user_id, log_msg);
-}
-
-void manage_inventory(char *user_id)
-{
-    int choice;
-    int i;
-    do
-    {
-        printf("\n=== INVENTORY MANAGEMENT ===\n");
-        printf("1. View Inventory\n2. Add Item\n3. Update Quantity\n4. Check Low Stock\n5. Exit\n");
-        printf("Enter choice: ");
-        scanf("%d", &choice);
-        switch (choice)
-        {
-        case 1:
-            printf("Inventory:\n");
-            printf("ID\tName\tCategory\tQuantity\tPrice\tReorder Level\n");
-            for (i = 0; i < inventory_count; i++)
-            {
-                printf("%d\t%s\t%s\t%d\t$%.2f\t%d\n",
-                       inventory[i].item_id, inventory[i].name, inventory[i].category,
-                       inventory[i].quantity, inventory[i].unit_price, inventory[i].reorder_level);
-            }
-            break;
-        case 2:
-            if (inventory_count >= MAX_INVENTORY)
-            {
-                printf("Max inventory reached!\n");
-                break;
-            }
-            printf("Enter item name: ");
-            scanf(" %[^\n]", inventory[inventory_count].name);
-            printf("Enter category: ");
-            scanf(" %[^\n]", inventory[inventory_count].category);
-            printf("Enter quantity: ");
-            scanf("%d", &inventory[inventory_count].quantity);
-            printf("Enter unit price: ");
-            scanf("%f", &inventory[inventory_count].unit_price);
-            printf("Enter reorder level: ");
-            scanf("%d", &inventory[inventory_count].reorder_level);
-            inventory[inventory_count].item_id = inventory_count + 1;
-            inventory_count++;
-            printf("Item added!\n");
-            log_activity(user_id, "Added new inventory item");
-            break;
-        case 3:
-            printf("Enter item ID: ");
-            int id;
-            scanf("%d", &id);
-            int found = 0;
-            for (i = 0; i < inventory_count; i++)
-            {
-                if (inventory[i].item_id == id)
-                {
-                    found = 1;
-                    int qty;
-                    printf("Enter new quantity: ");
-                    scanf("%d", &qty);
-                    inventory[i].quantity = qty;
-                    printf("Quantity updated!\n");
-                    char log_msg[100];
-                    sprintf(log_msg, "Updated quantity for item %d", id);
-                    log_activity(user_id, log_msg);
-                    break;
-                }
-            }
-            if (!found)
-                printf("Item not found!\n");
-            break;
-        case 4:
-            printf("Low Stock Items:\n");
-            for (i = 0; i < inventory_count; i++)
-            {
-                if (inventory[i].quantity <= inventory[i].reorder_level)
-                {
-                    printf("%d\t%s\t%d (Reorder at %d)\n",
-                           inventory[i].item_id, inventory[i].name,
-                           inventory[i].quantity, inventory[i].reorder_level);
-                }
-            }
-            break;
-        case 5:
-            break;
-        default:
-            printf("Invalid choice!\n");
-        }
-    } while (choice != 5);
-}
-
-void manage_events(char *user_id)
-{
-    int choice;
-    int i;
-    do
-    {
-        printf("\n=== EVENT MANAGEMENT ===\n");
-        printf("1. View Events\n2. Add Event\n3. Update Event Status\n4. Exit\n");
-        printf("Enter choice: ");
-        scanf("%d", &choice);
-        switch (choice)
-        {
-        case 1:
-            printf("Events:\n");
-            printf("ID\tName\tDate\tTime\tFacility\tStatus\n");
-            for (i = 0; i < event_count; i++)
-            {
-                char *status[] = {"Planned", "Ongoing", "Completed"};
-                printf("%d\t%s\t%02d/%02d/%d\t%s\t%s\t%s\n",
-                       events[i].event_id, events[i].name,
-                       events[i].date.day, events[i].date.month, events[i].date.year,
-                       events[i].time, facilities[events[i].facility_id - 1].name,
-                       status[events[i].status]);
-            }
-            break;
-        case 2:
-            if (event_count >= MAX_EVENTS)
-            {
-                printf("Max events reached!\n");
-                break;
-            }
-            printf("Enter event name: ");
-            scanf(" %[^\n]", events[event_count].name);
-            printf("Enter date (dd mm yyyy): ");
-            scanf("%d %d %d", &events[event_count].date.day,
-                  &events[event_count].date.month, &events[event_count].date.year);
-            printf("Enter time (HH:MM): ");
-            scanf("%s", events[event_count].time);
-            printf("Enter facility ID: ");
-            scanf("%d", &events[event_count].facility_id);
-            printf("Enter organizer: ");
-            scanf(" %[^\n]", events[event_count].organizer);
-            printf("Enter capacity: ");
-            scanf("%d", &events[event_count].capacity);
-            printf("Enter cost: ");
-            scanf("%f", &events[event_count].cost);
-            events[event_count].event_id = event_count + 1;
-            events[event_count].status = 0;
-            event_count++;
-            printf("Event added!\n");
-            char log_msg[100];
-            sprintf(log_msg, "Added event %s", events[event_count - 1].name);
-            log_activity(user_id, log_msg);
-            break;
-        case 3:
-            printf("Enter event ID: ");
-            int id;
-            scanf("%d", &id);
-            int found = 0;
-            for (i = 0; i < event_count; i++)
-            {
-                if (events[i].event_id == id)
-                {
-                    found = 1;
-                    printf("Current status: %s\n1. Mark as Ongoing\n2. Mark as Completed\n",
-                           events[i].status == 0 ? "Planned" : events[i].status == 1 ? "Ongoing"
-                                                                                     : "Completed");
-                    int status;
-                    printf("Enter new status: ");
-                    scanf("%d", &status);
-                    if (status == 1 || status == 2)
-                    {
-                        events[i].status = status;
-                        printf("Status updated!\n");
-                        char log_msg[100];
-                        sprintf(log_msg, "Updated event %d status", id);
-                        log_activity(user_id, log_msg);
-                    }
-                    else
-                    {
-                        printf("Invalid status!\n");
-                    }
-                    break;
-                }
-            }
-            if (!found)
-                printf("Event not found!\n");
-            break;
-        case 4:
-            break;
-        default:
-            printf("Invalid choice!\n");
-        }
-    } while (choice != 4);
-}
-
-void manage_staff_schedule(char *user_id)
-{
-    int choice;
-    int i;
-    do
-    {
-        printf("\n=== STAFF SCHEDULING ===\n");
-        printf("1. View Schedules\n2. Add Schedule\n3. Update Schedule\n4. Exit\n");
-        printf("Enter choice: ");
-        scanf("%d", &choice);
-        switch (choice)
-        {
-        case 1:
-            printf("Schedules:\n");
-            printf("ID\tStaff ID\tDate\tShift\tTask\n");
-            for (i = 0; i < schedule_count; i++)
-            {
-                printf("%d\t%s\t%02d/%02d/%d\t%s\t%s\n",
-                       schedules[i].schedule_id, schedules[i].staff_id,
-                       schedules[i].date.day, schedules[i].date.month, schedules[i].date.year,
-                       schedules[i].shift, schedules[i].task);
-            }
-            break;
-        case 2:
-            if (schedule_count >= MAX_SCHEDULES)
-            {
-                printf("Max schedules reached!\n");
-                break;
-            }
-            printf("Enter staff ID: ");
-            scanf("%s", schedules[schedule_count].staff_id);
-            int staff_found = 0;
-            for (i = 0; i < user_count; i++)
-            {
-                if (strcmp(users[i].id, schedules[schedule_count].staff_id) == 0)
-                {
-                    staff_found = 1;
-                    break;
-                }
-            }
-            if (!staff_found)
-            {
-                printf("Staff ID not found!\n");
-                break;
-            }
-            printf("Enter date (dd mm yyyy): ");
-            scanf("%d %d %d", &schedules[schedule_count].date.day,
-                  &schedules[schedule_count].date.month, &schedules[schedule_count].date.year);
-            printf("Enter shift (Morning/Evening/Night): ");
-            scanf("%s", schedules[schedule_count].shift);
-            printf("Enter task: ");
-            scanf(" %[^\n]", schedules[schedule_count].task);
-            schedules[schedule_count].schedule_id = schedule_count + 1;
-            schedule_count++;
-            printf("Schedule added!\n");
-            char log_msg[100];
-            sprintf(log_msg, "Added schedule for staff %s", schedules[schedule_count - 1].staff_id);
-            log_activity(user_id, log_msg);
-            break;
-        case 3:
-            printf("Enter schedule ID: ");
-            int id;
-            scanf("%d", &id);
-            int found = 0;
-            for (i = 0; i < schedule_count; i++)
-            {
-                if (schedules[i].schedule_id == id)
-                {
-                    found = 1;
-                    printf("Current Schedule: %s, %s, %02d/%02d/%d\n",
-                           schedules[i].staff_id, schedules[i].shift,
-                           schedules[i].date.day, schedules[i].date.month, schedules[i].date.year);
-                    printf("Enter new shift: ");
-                    scanf("%s", schedules[i].shift);
-                    printf("Enter new task: ");
-                    scanf(" %[^\n]", schedules[i].task);
-                    printf("Schedule updated!\n");
-                    char log_msg[100];
-                    sprintf(log_msg, "Updated schedule %d", id);
-                    log_activity(user_id, log_msg);
-                    break;
-                }
-            }
-            if (!found)
-                printf("Schedule not found!\n");
-            break;
-        case 4:
-            break;
-        default:
-            printf("Invalid choice!\n");
-        }
-    } while (choice != 4);
-}
-
-void generate_bill(char *user_id)
-{
-    if (bill_count >= MAX_BILLS)
-    {
-        printf("Max bills reached!\n");
-        return;
-    }
-    char guest_id[MAX_ID];
-    printf("Enter guest ID: ");
-    scanf("%s", guest_id);
-    Guest *guest = find_guest_in_list(guest_list, guest_id);
-    if (guest == NULL)
-    {
-        printf("Guest not found!\n");
-        return;
-    }
-    char booking_id[10];
-    printf("Enter booking ID: ");
-    scanf("%s", booking_id);
-    BookingNode *booking = find_booking(booking_tree, booking_id);
-    if (booking == NULL || strcmp(booking->guest_id, guest_id) != 0)
-    {
-        printf("Invalid booking ID!\n");
-        return;
-    }
-    float room_charges = 0, service_charges = 0, facility_charges = 0;
-    if (booking->room_no != -1)
-    {
-        room_charges = booking->total;
-    }
-    if (booking->facility_id != -1)
-    {
-        facility_charges = booking->total;
-    }
-    int i;
-    for (i = 0; i < service_count; i++)
-    {
-        if (services[i].room_no == booking->room_no && strcmp(services[i].status, "Completed") == 0)
-        {
-            service_charges += services[i].charge;
-        }
-    }
-    float taxes = (room_charges + service_charges + facility_charges) * 0.1; // 10% tax
-    float total = room_charges + service_charges + facility_charges + taxes;
-    bills[bill_count].bill_id = bill_count + 1;
-    strcpy(bills[bill_count].guest_id, guest_id);
-    strcpy(bills[bill_count].booking_id, booking_id);
-    bills[bill_count].room_charges = room_charges;
-    bills[bill_count].service_charges = service_charges;
-    bills[bill_count].facility_charges = facility_charges;
-    bills[bill_count].taxes = taxes;
-    bills[bill_count].total = total;
-    bills[bill_count].status = 0;
-    bills[bill_count].issue_date = get_current_date();
-    printf("\n=== BILL GENERATED ===\n");
-    printf("Bill ID: %d\nGuest: %s\nBooking ID: %s\n", bills[bill_count].bill_id, guest_id, booking_id);
-    printf("Room Charges: $%.2f\nService Charges: $%.2f\nFacility Charges: $%.2f\n",
-           room_charges, service_charges, facility_charges);
-    printf("Taxes (10%%): $%.2f\nTotal: $%.2f\nStatus: Unpaid\n", taxes, total);
-    bill_count++;
-    char log_msg[100];
-    sprintf(log_msg, "Generated bill %d for guest %s", bills[bill_count - 1].bill_id, guest_id);
-    log_activity(user_id, log_msg);
-}
-
-void process_payment(char *user_id)
-{
-    printf("Enter bill ID: ");
-    int i;
-    int id;
-    scanf("%d", &id);
-    int found = 0;
-    for (i = 0; i < bill_count; i++)
-    {
-        if (bills[i].bill_id == id)
-        {
-            found = 1;
-            if (bills[i].status == 1)
-            {
-                printf("Bill already paid!\n");
-                return;
-            }
-            printf("Bill Details:\nTotal: $%.2f\n", bills[i].total);
-            printf("1. Pay by Cash\n2. Pay by Card\n3. Cancel\n");
-            int method;
-            printf("Enter payment method: ");
-            scanf("%d", &method);
-            if (method == 1 || method == 2)
-            {
-                bills[i].status = 1;
-                total_revenue += bills[i].total;
-                Guest *guest = find_guest_in_list(guest_list, bills[i].guest_id);
-                if (guest != NULL)
-                {
-                    guest->loyalty_points += (int)(bills[i].total / 100) * LOYALTY_POINTS_RATE;
-                }
-                printf("Payment successful! Bill marked as paid.\n");
-                char log_msg[100];
-                sprintf(log_msg, "Processed payment for bill %d", id);
-                log_activity(user_id, log_msg);
-            }
-            else
-            {
-                printf("Payment cancelled.\n");
-            }
-            break;
-        }
-    }
-    if (!found)
-        printf("Bill not found!\n");
-}
-
-void analytics_dashboard(char *user_id)
-{
-    int i;
-    printf("\n=== ANALYTICS DASHBOARD ===\n");
-    int occupied_rooms = 0;
-    for (i = 0; i < MAX_ROOMS; i++)
-    {
-        if (rooms[i].status == 1)
-            occupied_rooms++;
-    }
-    printf("Room Occupancy: %d/%d (%.2f%%)\n", occupied_rooms, MAX_ROOMS,
-           (float)occupied_rooms / MAX_ROOMS * 100);
-    int occupied_parking = 0;
-    ParkingSlot *slot = parking_slots;
-    while (slot != NULL)
-    {
-        if (slot->status == 1)
-            occupied_parking++;
-        slot = slot->next;
-    }
-    printf("Parking Occupancy: %d/%d (%.2f%%)\n", occupied_parking, MAX_PARKING,
-           (float)occupied_parking / MAX_PARKING * 100);
-    float avg_rating = 0;
-    for (i = 0; i < feedback_count; i++)
-    {
-        avg_rating += feedbacks[i].rating;
-    }
-    avg_rating = feedback_count > 0 ? avg_rating / feedback_count : 0;
-    printf("Average Guest Rating: %.2f/5\n", avg_rating);
-    printf("Total Revenue: $%.2f\n", total_revenue);
-    printf("Pending Maintenance Requests: %d\n", maintenance_count);
-    printf("Active Bookings: %d\n", booking_count);
-    char log_msg[100];
-    sprintf(log_msg, "Viewed analytics dashboard");
-    log_activity(user_id, log_msg);
-}
-
-void view_logs(char *user_id)
-{
-    int i;
-    if (log_count == 0)
-    {
-        printf("No logs available!\n");
-        return;
-    }
-    printf("\n=== SYSTEM LOGS ===\n");
-    printf("ID\tUser\tAction\tDate\tTime\n");
-    for (i = 0; i < log_count; i++)
-    {
-        printf("%d\t%s\t%s\t%02d/%02d/%d\t%s\n",
-               logs[i].log_id, logs[i].user_id, logs[i].action,
-               logs[i].date.day, logs[i].date.month, logs[i].date.year, logs[i].time);
-    }
-    char log_msg[100];
-    sprintf(log_msg, "Viewed system logs");
-    log_activity(user_id, log_msg);
-}
-
-void login()
-{
-    int i;
-    char id[MAX_ID], pass[MAX_PASS];
-    printf("Enter ID: ");
-    scanf("%s", id);
-    printf("Enter password: ");
-    scanf("%s", pass);
-    int access_level = 0;
-    char user_id[MAX_ID];
-    for (i = 0; i < user_count; i++)
-    {
-        if (strcmp(users[i].id, id) == 0 && strcmp(users[i].pass, pass) == 0)
-        {
-            access_level = users[i].access_level;
-            strcpy(user_id, users[i].id);
-            break;
-        }
-    }
-    if (access_level == 0)
-    {
-        printf("Invalid credentials!\n");
-        return;
-    }
-    printf("Login successful! Access level: %d\n", access_level);
-    int choice;
-    do
-    {
-        printf("\n=== HOTEL MANAGEMENT SYSTEM ===\n");
-        printf("1. Add Guest\n2. View Guest Details\n3. Book Room\n4. Assign Parking\n");
-        printf("5. Process Parking Waitlist\n6. Book Facility\n7. Order Room Service\n");
-        printf("8. Update Service Status\n9. Report Maintenance\n10. Update Maintenance Status\n");
-        printf("11. Submit Feedback\n12. Manage Inventory\n13. Manage Events\n");
-        printf("14. Manage Staff Schedule\n15. Generate Bill\n16. Process Payment\n");
-        printf("17. Analytics Dashboard\n");
-        if (access_level >= 5)
-            printf("18. View System Logs\n19. Exit\n");
-        else
-            printf("18. Exit\n");
-        printf("Enter choice: ");
-        scanf("%d", &choice);
-        switch (choice)
-        {
-        case 1:
-            add_guest(user_id);
-            break;
-        case 2:
-            view_guest_details();
-            break;
-        case 3:
-            book_room(user_id);
-            break;
-        case 4:
-            assign_parking(user_id);
-            break;
-        case 5:
-            process_waitlist(user_id);
-            break;
-        case 6:
-            book_facility(user_id);
-            break;
-        case 7:
-            order_room_service(user_id);
-            break;
-        case 8:
-            update_service_status(user_id);
-            break;
-        case 9:
-            report_maintenance(user_id);
-            break;
-        case 10:
-            update_maintenance_status(user_id);
-            break;
-        case 11:
-            submit_feedback(user_id);
-            break;
-        case 12:
-            manage_inventory(user_id);
-            break;
-        case 13:
-            manage_events(user_id);
-            break;
-        case 14:
-            manage_staff_schedule(user_id);
-            break;
-        case 15:
-            generate_bill(user_id);
-            break;
-        case 16:
-            process_payment(user_id);
-            break;
-        case 17:
-            analytics_dashboard(user_id);
-            break;
-        case 18:
-            if (access_level >= 5)
-                view_logs(user_id);
-            else
-                choice = 19;
-            break;
-        case 19:
-            if (access_level >= 5)
-                break;
-            else
-                printf("Invalid choice!\n");
-            break;
-        default:
-            printf("Invalid choice!\n");
-        }
-    } while (choice != (access_level >= 5 ? 19 : 18));
-}
-
-int main()
-{
-    init_system();
-    printf("Welcome to Hotel Management System\n");
-    login();
-    return 0;
+#define _GNU_SOURCE // accept4, pipe2
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <strings.h>
+#include <unistd.h> // For sleep function
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <signal.h>
+#include <errno.h>
+#include <poll.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define MAX_ROOMS 50
+#define MAX_PARKING 30
+#define MAX_WAITLIST 64 // Ring capacity, power of two
+#define MAX_STAFF 20
+#define MAX_NAME 50
+#define MAX_ID 15
+#define MAX_PASS 20
+#define FACILITY_FILE "hotel_facilities.conf"
+#define FLOOR_LIFT_METRES 15 // Walk between adjacent floors
+#define NEARBY_FACILITIES 4
+#define TABLE_CHUNK 1024 // Records per table chunk; chunks never move once allocated
+#define POOL_SLAB_NODES 1024 // Nodes carved from each pool slab
+#define LOG_RING_SIZE 4096   // Activity log ring slots, power of two
+#define LOG_IDLE_USEC 2000   // Writer poll interval when the ring is empty
+#define LOG_FILE "hotel_activity.log"
+#define SNAPSHOT_FILE "hotel_state.snap"
+#define SNAPSHOT_VERSION 9
+#define SNAPSHOT_ALIGN 64 // Section alignment inside the snapshot file
+#define WAL_FILE "hotel_wal.bin"
+#define BATCH_LINE 1024     // Longest batch command line
+#define BATCH_MAX_FIELDS 8  // Command name plus its fields
+#define SERVER_SOCKET "hotel.sock"
+#define SERVER_BUFFER 65536        // Unprocessed input held per connection
+#define SERVER_EVENTS 64           // epoll events handled per wakeup
+#define SERVER_REPLY 4096          // Longest reply line, a week of free facility slots
+#define SERVER_WORKERS_PER_CPU 2   // Workers mostly wait on group commit, so oversubscribe
+#define BENCH_LOOKUPS 1000000 // Lookups timed per benchmark size
+#define BENCH_YEAR 2030
+#define DISCOUNT_THRESHOLD 1000
+#define LOYALTY_POINTS_RATE 10 // Points per $100 spent
+#define CALENDAR_START_YEAR 2023 // Earliest year accepted by is_valid_date
+#define DATE_MIN_YEAR 1970 // Day 0 of the Date count
+#define DATE_MAX_YEAR 2100
+#define DATE_INVALID (-1)
+#define DATE_TEXT 11 // "dd/mm/yyyy" plus terminator
+#define CALENDAR_DAYS (78 * 366)  // Covers 2023-2100
+#define ROOM_WORDS ((MAX_ROOMS + 63) / 64)
+#define ROOM_SLOTS ((MAX_ROOMS + 15) / 16 * 16) // Room columns padded to whole vector blocks
+#define ROOM_UNCHECKED 0xFFFFFFFFu // Room versions are even once read, so odd values are free for sentinels
+#define ROOM_RESERVED 0xFFFFFFFDu  // Nights already taken by execute_operation
+#define ROOM_REPLAYED 0xFFFFFFFBu  // Log replay: the status check passed when the booking first ran
+#define MAX_FEATURES 32 // Bits in a room's feature set
+#define FEATURE_NAME 20
+#define CALENDAR_MONTHS (78 * 12)
+#define SLOTS_PER_DAY 48 // Half-hour facility slots
+#define SLOT_MINUTES 30
+#define DAY_SLOTS ((1ULL << SLOTS_PER_DAY) - 1)
+#define SLOT_PAGE_DAYS 32 // Days per lazily allocated facility slot page
+#define SLOT_PAGES ((CALENDAR_DAYS + SLOT_PAGE_DAYS - 1) / SLOT_PAGE_DAYS)
+#define MAX_FACILITY_CAPACITY 255 // Bookings per slot fit an unsigned char
+#define FREE_SLOTS_DAYS 7 // Days shown when a facility is full
+#define NO_POINTS_KIND "spa" // Facility kind whose bookings earn no loyalty points
+#define SLOT_TEXT 6          // "HH:MM" plus terminator
+#define FREE_SLOTS_TEXT 300  // Every other slot free: 24 ranges
+#define ROLLUP_TYPES 4                       // Room types 1-3, 0 for charges without a room
+#define FLOORS ((MAX_ROOMS + 9) / 10) // Ten rooms per floor
+#define ROLLUP_FLOORS (FLOORS + 1)    // Floors from 1, 0 for charges without a room
+#define PARKING_WORDS ((MAX_PARKING + 64) / 64) // Bit per slot number 1..MAX_PARKING
+#define BOOKING_ID_LEN 6
+#define BOOKING_ID_SPACE 2176782336ULL // 36^6 distinct booking IDs
+#define BOOKING_ID_MULTIPLIER 2654435761ULL // Coprime to 36, so the scramble is a bijection
+
+// Date as days since 01/01/DATE_MIN_YEAR, so comparisons and differences are one subtraction
+typedef int Date;
+
+// Calendar fields of a date; as a report period, day 0 means a whole month and month 0 a whole year
+typedef struct
+{
+    int day, month, year;
+} DateParts;
+
+// Guest structure with linked list for history
+typedef struct Guest
+{
+    char id[MAX_ID];
+    char name[MAX_NAME];
+    char contact[15];
+    char email[50];
+    int loyalty_points;
+    char preferences[100];
+    struct BookingNode *bookings; // This guest's bookings, ordered by check-in
+    struct Guest *next;
+} Guest;
+
+// Rooms stored as columns indexed by room number - 1, so filters scan only the attributes they test
+typedef struct
+{
+    unsigned char status[ROOM_SLOTS]; // 0: Available, 1: Booked, 2: Maintenance
+    unsigned char type[ROOM_SLOTS];   // 1: Standard, 2: Deluxe, 3: Suite
+    unsigned char floor[ROOM_SLOTS];
+    unsigned char capacity[ROOM_SLOTS];
+    float price[ROOM_SLOTS];
+    unsigned int features[ROOM_SLOTS];                       // Bit per interned feature
+    unsigned long long feature_rooms[MAX_FEATURES][ROOM_WORDS]; // Rooms having each feature
+    char feature_names[MAX_FEATURES][FEATURE_NAME];
+    int feature_count;
+} RoomColumns;
+
+// Room search criteria; zero leaves a criterion open
+typedef struct
+{
+    int type;
+    int floor_min, floor_max;
+    int capacity_min;
+    float price_max;
+    unsigned int features_all; // Every one of these features
+    unsigned int features_any; // At least one of these features
+} RoomFilter;
+
+// Parking structure with linked list for waiting queue
+typedef struct ParkingSlot
+{
+    int slot_no;
+    int status; // 0: Available, 1: Occupied, 2: Reserved
+    char vehicle[20];
+    char guest_id[MAX_ID];
+    struct ParkingSlot *next;
+} ParkingSlot;
+
+// Parking waitlist entry
+typedef struct
+{
+    char vehicle[20];
+    char guest_id[MAX_ID];
+} WaitlistEntry;
+
+// Live counters and gauges, updated where the underlying state changes
+typedef struct
+{
+    atomic_long rooms_occupied;
+    atomic_long rooms_in_maintenance;
+    atomic_long bookings_upcoming;
+    atomic_long bookings_active;
+    atomic_long bookings_completed;
+    atomic_long services_pending; // Ordered but not yet completed
+    atomic_long maintenance_open; // Reported but not yet resolved
+    atomic_long parking_occupied;
+    atomic_long feedback_count;
+    atomic_long rating_sum;
+} Metrics;
+
+// Aggregates for one day or month, room type and floor
+typedef struct
+{
+    float revenue;    // Payments recognised
+    float room_sales; // Booked room rate, for ADR
+    int room_nights;  // Nights sold
+} RollupBucket;
+
+// One month of daily buckets plus the month's running total
+typedef struct
+{
+    int month; // Months since January of CALENDAR_START_YEAR
+    RollupBucket days[31][ROLLUP_TYPES][ROLLUP_FLOORS];
+    RollupBucket total[ROLLUP_TYPES][ROLLUP_FLOORS];
+} RollupPage;
+
+// Facility structure
+typedef struct
+{
+    int facility_id;
+    char name[30];
+    char kind[20]; // Matched by nearest-facility queries, e.g. "spa" or "pool"
+    int capacity;  // Guests per half-hour slot
+    float booking_fee;
+} Facility;
+
+// One facility's slot bookings for SLOT_PAGE_DAYS consecutive days
+typedef struct
+{
+    unsigned long long full[SLOT_PAGE_DAYS];                // Bit per slot: no capacity left
+    unsigned char booked[SLOT_PAGE_DAYS][SLOTS_PER_DAY];    // Bookings holding each slot
+} SlotPage;
+
+// Walking distance from a graph node to one facility
+typedef struct
+{
+    float metres; // INFINITY if unreachable
+    int facility; // Index into facilities
+} FacilityDistance;
+
+// Activity log ring slot; sequence follows the bounded MPMC queue protocol
+typedef struct
+{
+    atomic_ulong sequence;
+    char user_id[MAX_ID];
+    char action[100];
+    long timestamp; // Coarse clock seconds at the time of the action
+} LogRecord;
+
+// Hash index slot: cached hash plus the record's own key, so probes rarely touch records
+typedef struct
+{
+    unsigned int hash;
+    const char *key;
+    void *value;
+} IndexSlot;
+
+// Open-addressing (linear probing) index over string keys
+typedef struct
+{
+    IndexSlot *slots;
+    int capacity; // Always a power of two
+    int count;
+} StringIndex;
+
+// Growable record table: fixed-size chunks so record addresses stay stable
+typedef struct
+{
+    size_t elem_size;
+    char **chunks;
+    int chunk_count, chunk_capacity;
+    int adopted_chunks; // Leading chunks that live in the snapshot map, not owned
+    int count;
+} Table;
+
+// Typed node pool: slabs carved by pointer bump and released together
+typedef struct
+{
+    const char *name;
+    size_t node_size;
+    char *slabs; // Each slab starts with a pointer to the previous slab
+    char *bump, *bump_end;
+    long slab_count, in_use, peak, total_allocs;
+} Pool;
+
+// Snapshot sections, each a packed array of fixed-size records
+enum
+{
+    SNAP_ROOMS,
+    SNAP_CALENDAR,
+    SNAP_USERS,
+    SNAP_GUESTS,
+    SNAP_BOOKINGS, // In check-in order
+    SNAP_PARKING,
+    SNAP_WAITLIST, // Oldest first
+    SNAP_SERVICES,
+    SNAP_MAINTENANCE,
+    SNAP_FEEDBACKS,
+    SNAP_INVENTORY,
+    SNAP_EVENTS,
+    SNAP_SCHEDULES,
+    SNAP_BILLS,
+    SNAP_LOGS,
+    SNAP_ROLLUPS,
+    SNAPSHOT_SECTIONS
+};
+
+// Location of one snapshot section
+typedef struct
+{
+    long long offset; // From the start of the file
+    long long count;
+    long long elem_size; // Guards against loading records with a different layout
+} SnapshotSection;
+
+// Snapshot file header
+typedef struct
+{
+    char magic[8];
+    int version;
+    int user_count;
+    unsigned long long booking_id_seq;
+    unsigned long long wal_lsn; // Last write-ahead log record included in the snapshot
+    float total_revenue;
+    SnapshotSection sections[SNAPSHOT_SECTIONS];
+} SnapshotHeader;
+
+// Operation types recorded in the write-ahead log
+enum
+{
+    OP_ADD_GUEST = 1,
+    OP_BOOK_ROOM,
+    OP_ASSIGN_PARKING,
+    OP_PROCESS_WAITLIST,
+    OP_BOOK_FACILITY,
+    OP_ORDER_SERVICE,
+    OP_UPDATE_SERVICE,
+    OP_REPORT_MAINTENANCE,
+    OP_UPDATE_MAINTENANCE,
+    OP_SUBMIT_FEEDBACK,
+    OP_ADD_ITEM,
+    OP_UPDATE_QUANTITY,
+    OP_ADD_EVENT,
+    OP_UPDATE_EVENT,
+    OP_ADD_SCHEDULE,
+    OP_UPDATE_SCHEDULE,
+    OP_GENERATE_BILL,
+    OP_PROCESS_PAYMENT,
+    OP_ADVANCE_CLOCK,
+    OP_TYPES
+};
+
+// Outcome of applying an operation; indexes status_messages
+typedef enum
+{
+    ST_OK,
+    ST_GUEST_EXISTS,
+    ST_GUEST_NOT_FOUND,
+    ST_INVALID_DATES,
+    ST_INVALID_DATE,
+    ST_ROOM_UNAVAILABLE,
+    ST_ROOM_CHANGED,
+    ST_INVALID_ROOM,
+    ST_ROOM_NOT_OCCUPIED,
+    ST_INVALID_CHOICE,
+    ST_PARKING_HELD,
+    ST_ALREADY_WAITLISTED,
+    ST_WAITLIST_FULL,
+    ST_WAITLIST_EMPTY,
+    ST_FACILITY_UNAVAILABLE,
+    ST_INVALID_FACILITY,
+    ST_INVALID_SLOT,
+    ST_SERVICE_NOT_FOUND,
+    ST_SERVICE_COMPLETED,
+    ST_INVALID_ISSUE,
+    ST_INVALID_PRIORITY,
+    ST_REQUEST_NOT_FOUND,
+    ST_REQUEST_RESOLVED,
+    ST_INVALID_RATING,
+    ST_ITEM_NOT_FOUND,
+    ST_EVENT_NOT_FOUND,
+    ST_INVALID_STATUS,
+    ST_STAFF_NOT_FOUND,
+    ST_SCHEDULE_NOT_FOUND,
+    ST_INVALID_BOOKING,
+    ST_BILL_NOT_FOUND,
+    ST_BILL_PAID,
+    ST_IO_ERROR,
+    ST_STATUSES
+} OpStatus;
+
+// New guest
+typedef struct
+{
+    char id[MAX_ID];
+    char name[MAX_NAME];
+    char contact[15];
+    char email[50];
+    char preferences[100];
+} GuestOp;
+
+// Room or facility reservation
+typedef struct
+{
+    char guest_id[MAX_ID];
+    int room_no;
+    int facility_id;
+    Date check_in, check_out;
+    int slot, slots; // Facility bookings: first half-hour slot and how many
+} BookingOp;
+
+// Parking request
+typedef struct
+{
+    char guest_id[MAX_ID];
+    char vehicle[20];
+} ParkingOp;
+
+// Room service order
+typedef struct
+{
+    int room_no;
+    int item; // 1-5 from the service menu
+    char time[10];
+} ServiceOrderOp;
+
+// Status change on a record by ID (service, maintenance, event, payment method)
+typedef struct
+{
+    int id;
+    int choice;
+} StatusOp;
+
+// Maintenance report
+typedef struct
+{
+    int room_no;
+    int issue_type;
+    int priority;
+    char description[100];
+    Date date;
+} MaintenanceOp;
+
+// Guest feedback
+typedef struct
+{
+    char guest_id[MAX_ID];
+    char comment[200];
+    int rating;
+    Date date;
+} FeedbackOp;
+
+// New inventory item
+typedef struct
+{
+    char name[50];
+    char category[30];
+    int quantity;
+    float unit_price;
+    int reorder_level;
+} ItemOp;
+
+// Inventory quantity update
+typedef struct
+{
+    int id;
+    int quantity;
+} QuantityOp;
+
+// New event
+typedef struct
+{
+    char name[50];
+    Date date;
+    char time[10];
+    int facility_id;
+    char organizer[MAX_NAME];
+    int capacity;
+    float cost;
+} EventOp;
+
+// Staff schedule add (staff, date) or update (id)
+typedef struct
+{
+    int id;
+    char staff_id[MAX_ID];
+    Date date;
+    char shift[20];
+    char task[50];
+} ScheduleOp;
+
+// Bill payment
+typedef struct
+{
+    int id;
+    int method; // 1: Cash, 2: Card
+    Date date;
+} PaymentOp;
+
+// Bill generation
+typedef struct
+{
+    char guest_id[MAX_ID];
+    char booking_id[10];
+    Date date;
+} BillOp;
+
+// Clock tick that fired booking transitions
+typedef struct
+{
+    Date date;
+} ClockOp;
+
+// One state mutation; the payload member is selected by type
+typedef struct
+{
+    int type;
+    unsigned int room_version; // Room version the caller's availability check saw, or a ROOM_ sentinel; not logged
+    union
+    {
+        GuestOp guest;
+        BookingOp booking;
+        ParkingOp parking;
+        ServiceOrderOp service;
+        StatusOp status;
+        MaintenanceOp maintenance;
+        FeedbackOp feedback;
+        ItemOp item;
+        QuantityOp quantity;
+        EventOp event;
+        ScheduleOp schedule;
+        BillOp bill;
+        PaymentOp payment;
+        ClockOp clock;
+    } data;
+} Operation;
+
+// Details reported back by an applied operation
+typedef struct
+{
+    int id;       // Record created or updated; parking slot (-1 when waitlisted)
+    int points;   // Loyalty points earned
+    float amount; // Discount applied
+    int count;    // Vehicles placed from the waitlist
+    struct BookingNode *booking;
+} OpResult;
+
+// Write-ahead log record header; the operation payload follows
+typedef struct
+{
+    unsigned int length;   // Payload bytes
+    unsigned int checksum; // FNV-1a over the payload
+    unsigned long long lsn;
+    int type;
+    int reserved;
+} WalRecordHeader;
+
+// Batch command: name, operation type, required and maximum field counts
+typedef struct
+{
+    char *name;
+    int type;
+    int min_fields, max_fields;
+} BatchCommand;
+
+// Shared state guarded by each subsystem lock; always acquired in this order, then room shards.
+// Room status is sharded by room word (room_locks); rollups have their own leaf lock.
+enum
+{
+    LOCK_GUESTS,      // Guest list, index and pool
+    LOCK_BOOKINGS,    // Booking tree and index, booking IDs, timers, room occupants
+    LOCK_FACILITIES,  // Facility slot calendars
+    LOCK_PARKING,     // Slots, free bitmap, guest index and waitlist
+    LOCK_SERVICES,
+    LOCK_MAINTENANCE,
+    LOCK_FEEDBACK,
+    LOCK_INVENTORY,
+    LOCK_EVENTS,
+    LOCK_SCHEDULES,
+    LOCK_BILLS, // Bills and total revenue
+    SUBSYSTEM_LOCKS
+};
+
+// Server client; held by at most one worker at a time so replies keep request order
+typedef struct Connection
+{
+    int fd;
+    char input[SERVER_BUFFER];
+    size_t input_used;
+    int queued; // Waiting for or held by a worker
+    int closed; // No more input; freed once no worker holds it
+    pthread_mutex_t lock;
+    struct Connection *next_ready;
+    struct Connection *prev, *next; // All open connections
+} Connection;
+
+// Booking structure with tree node
+typedef struct BookingNode
+{
+    char booking_id[10];
+    char guest_id[MAX_ID];
+    int room_no;
+    int parking_slot;
+    int facility_id;
+    Date check_in;
+    Date check_out;
+    unsigned char slot, slots; // Facility bookings: half-hour slots held on check_in
+    float total;
+    float service_charges; // Completed room service orders billed to this stay
+    int status; // 0: Upcoming, 1: Active, 2: Completed, 3: Cancelled
+    int height; // AVL subtree height
+    struct BookingNode *left;
+    struct BookingNode *right;
+    struct BookingNode *next_for_guest;
+} BookingNode;
+
+// Pending booking state transition for the timer heap
+typedef struct
+{
+    int day;  // calendar_day when the transition is due
+    int type; // 0: Check-out, 1: Check-in (check-outs fire first on a shared day)
+    struct BookingNode *booking;
+} BookingEvent;
+
+// User structure for staff/admin
+typedef struct User
+{
+    char id[MAX_ID];
+    char name[MAX_NAME];
+    char pass[MAX_PASS];
+    char role[10]; // "staff" or "admin"
+    char department[20];
+    int access_level;
+} User;
+
+// Room service structure
+typedef struct
+{
+    int service_id;
+    int room_no;
+    char booking_id[10]; // Stay the order is billed to
+    char items[100];
+    char time[10];
+    char status[20]; // "Pending", "In Progress", "Completed"
+    float charge;
+} RoomService;
+
+// Maintenance request structure
+typedef struct
+{
+    int request_id;
+    int room_no;
+    char issue[100];
+    char priority[10]; // "Low", "Medium", "High"
+    char status[20];   // "Open", "In Progress", "Resolved"
+    Date report_date;
+} MaintenanceRequest;
+
+// Feedback structure
+typedef struct
+{
+    int feedback_id;
+    char guest_id[MAX_ID];
+    char comment[200];
+    int rating; // 1-5
+    Date date;
+} Feedback;
+
+// Inventory item structure
+typedef struct
+{
+    int item_id;
+    char name[50];
+    int quantity;
+    float unit_price;
+    char category[30]; // "Food", "Housekeeping", "Maintenance", etc.
+    int reorder_level;
+} InventoryItem;
+
+// Event structure
+typedef struct
+{
+    int event_id;
+    char name[50];
+    Date date;
+    char time[10];
+    int facility_id;
+    char organizer[MAX_NAME];
+    int capacity;
+    float cost;
+    int status; // 0: Planned, 1: Ongoing, 2: Completed
+} Event;
+
+// Staff schedule structure
+typedef struct
+{
+    int schedule_id;
+    char staff_id[MAX_ID];
+    Date date;
+    char shift[20]; // "Morning", "Evening", "Night"
+    char task[50];
+} StaffSchedule;
+
+// Billing structure
+typedef struct
+{
+    int bill_id;
+    char guest_id[MAX_ID];
+    char booking_id[10];
+    float room_charges;
+    float service_charges;
+    float facility_charges;
+    float taxes;
+    float total;
+    int status; // 0: Unpaid, 1: Paid
+    Date issue_date;
+} Bill;
+
+// System log structure
+typedef struct
+{
+    int log_id;
+    char user_id[MAX_ID];
+    char action[100];
+    Date date;
+    char time[10];
+} SystemLog;
+
+// Global variables
+RoomColumns rooms;
+atomic_ullong room_calendar[CALENDAR_DAYS][ROOM_WORDS]; // Bit set: room booked that night
+atomic_uint room_versions[MAX_ROOMS]; // Odd while a room's calendar or status is being changed
+ParkingSlot *parking_slots = NULL;
+WaitlistEntry parking_waitlist[MAX_WAITLIST]; // FIFO ring buffer
+unsigned int waitlist_head = 0, waitlist_tail = 0; // Free-running; count is tail - head
+ParkingSlot *parking_by_no[MAX_PARKING + 1];
+unsigned long long parking_free[PARKING_WORDS]; // Bit set: slot available
+StringIndex parking_index = {NULL, 0, 0};      // Guest ID -> occupied slot
+Facility *facilities = NULL; // Loaded from FACILITY_FILE
+int facility_count = 0;
+int graph_nodes = 0;                        // Facilities first, then one node per floor
+float *graph_distance = NULL;               // graph_nodes x graph_nodes shortest walks in metres
+FacilityDistance *nearest_facilities = NULL; // Per node, every facility ordered nearest first
+SlotPage **slot_pages = NULL; // facility_count x SLOT_PAGES, allocated when first booked
+Pool guest_pool = {.name = "Guest", .node_size = sizeof(Guest)};
+Pool booking_pool = {.name = "BookingNode", .node_size = sizeof(BookingNode)};
+Pool parking_pool = {.name = "ParkingSlot", .node_size = sizeof(ParkingSlot)};
+Guest *guest_list = NULL;
+StringIndex guest_index = {NULL, 0, 0};
+BookingNode *booking_tree = NULL;
+BookingNode *room_occupant[MAX_ROOMS]; // Active stay per room, set and cleared by the timer
+StringIndex booking_index = {NULL, 0, 0};
+BookingEvent *booking_events = NULL; // Min-heap on (day, type)
+int booking_event_count = 0, booking_event_capacity = 0;
+unsigned long long booking_id_seq = 1;
+User users[MAX_STAFF + 1];
+Table services = {.elem_size = sizeof(RoomService)};
+Table maintenance = {.elem_size = sizeof(MaintenanceRequest)};
+Table feedbacks = {.elem_size = sizeof(Feedback)};
+Table inventory = {.elem_size = sizeof(InventoryItem)};
+Table events = {.elem_size = sizeof(Event)};
+Table schedules = {.elem_size = sizeof(StaffSchedule)};
+Table bills = {.elem_size = sizeof(Bill)};
+Table logs = {.elem_size = sizeof(SystemLog)}; // Filled by the log writer thread
+pthread_mutex_t logs_lock = PTHREAD_MUTEX_INITIALIZER;
+LogRecord log_ring[LOG_RING_SIZE];
+atomic_ulong log_enqueue_pos, log_dequeue_pos;
+atomic_long log_clock; // Refreshed by the writer so producers never call time()
+atomic_int log_writer_running;
+pthread_t log_writer;
+FILE *log_file = NULL;
+int guest_count = 0, booking_count = 0, user_count = 0;
+Metrics metrics;
+RollupPage *rollup_pages[CALENDAR_MONTHS]; // Allocated when a month is first touched
+int wal_fd = -1;
+pthread_mutex_t wal_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t wal_work = PTHREAD_COND_INITIALIZER;  // Signalled when records are buffered
+pthread_cond_t wal_synced = PTHREAD_COND_INITIALIZER; // Signalled after each group fsync
+char *wal_buffer = NULL, *wal_spare = NULL;          // Appends fill one while the other is written
+size_t wal_buffer_used = 0, wal_buffer_capacity = 0, wal_spare_capacity = 0;
+unsigned long long wal_last_lsn = 0;    // Last LSN assigned
+unsigned long long wal_durable_lsn = 0; // Last LSN on disk
+int wal_error = 0;                      // Sticky: a group failed to reach disk, so nothing later is durable
+int wal_running = 0;
+pthread_t wal_flusher;
+void *snapshot_map = NULL; // Loaded snapshot; adopted records live here
+size_t snapshot_map_size = 0;
+float total_revenue = 0;
+pthread_mutex_t subsystem_locks[SUBSYSTEM_LOCKS] = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER};
+// Room status and commits, one lock per calendar word of rooms, so different words never contend
+pthread_mutex_t room_locks[ROOM_WORDS] = {[0 ... ROOM_WORDS - 1] = PTHREAD_MUTEX_INITIALIZER};
+pthread_mutex_t rollup_lock = PTHREAD_MUTEX_INITIALIZER; // Leaf lock: nothing is taken while held
+Connection *ready_head = NULL, *ready_tail = NULL; // Connections with complete lines to serve
+Connection *connection_list = NULL;
+pthread_mutex_t ready_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t ready_work = PTHREAD_COND_INITIALIZER;
+int server_running = 0;
+int server_stop_pipe[2] = {-1, -1}; // Written by the signal handler to wake the event loop
+atomic_long server_requests, server_connections;
+
+// ======================== TABLE OPERATIONS ========================
+
+// Record at index (no bounds check)
+void *table_at(Table *table, int i)
+{
+    return table->chunks[i / TABLE_CHUNK] + (size_t)(i % TABLE_CHUNK) * table->elem_size;
+}
+
+// Append a zeroed record; only the chunk directory is ever reallocated
+void *table_push(Table *table)
+{
+    if (table->count == table->chunk_count * TABLE_CHUNK)
+    {
+        if (table->chunk_count == table->chunk_capacity)
+        {
+            table->chunk_capacity = table->chunk_capacity ? table->chunk_capacity * 2 : 8;
+            table->chunks = (char **)realloc(table->chunks, table->chunk_capacity * sizeof(char *));
+        }
+        table->chunks[table->chunk_count++] = (char *)malloc(TABLE_CHUNK * table->elem_size);
+    }
+    void *record = table_at(table, table->count++);
+    memset(record, 0, table->elem_size);
+    return record;
+}
+
+// Record by 1-based sequential ID, or NULL if out of range
+void *table_find(Table *table, int id)
+{
+    if (id < 1 || id > table->count)
+        return NULL;
+    return table_at(table, id - 1);
+}
+
+// Free the table's own chunks and empty it; IDs start again from 1
+void table_free(Table *table)
+{
+    int i;
+    for (i = table->adopted_chunks; i < table->chunk_count; i++)
+        free(table->chunks[i]);
+    free(table->chunks);
+    table->chunks = NULL;
+    table->chunk_count = table->chunk_capacity = table->adopted_chunks = 0;
+    table->count = 0;
+}
+
+// Use an external array of records in place; only a partial last chunk is copied
+void table_adopt(Table *table, char *records, int count)
+{
+    int i;
+    int full = count / TABLE_CHUNK;
+    table_free(table);
+    table->adopted_chunks = full;
+    for (i = 0; i < full; i++)
+    {
+        if (table->chunk_count == table->chunk_capacity)
+        {
+            table->chunk_capacity = table->chunk_capacity ? table->chunk_capacity * 2 : 8;
+            table->chunks = (char **)realloc(table->chunks, table->chunk_capacity * sizeof(char *));
+        }
+        table->chunks[table->chunk_count++] = records + (size_t)i * TABLE_CHUNK * table->elem_size;
+        table->count += TABLE_CHUNK;
+    }
+    for (i = full * TABLE_CHUNK; i < count; i++)
+        memcpy(table_push(table), records + (size_t)i * table->elem_size, table->elem_size);
+}
+
+// ======================== POOL OPERATIONS ========================
+
+// Slot size rounded up so every node stays 16-byte aligned
+size_t pool_stride(Pool *pool)
+{
+    return (pool->node_size + 15) & ~(size_t)15;
+}
+
+// Allocate one node by bumping within the current slab; nodes are only released in bulk
+void *pool_alloc(Pool *pool)
+{
+    size_t stride = pool_stride(pool);
+    if (pool->bump == pool->bump_end)
+    {
+        char *slab = (char *)malloc(16 + stride * POOL_SLAB_NODES);
+        *(char **)slab = pool->slabs;
+        pool->slabs = slab;
+        pool->bump = slab + 16;
+        pool->bump_end = pool->bump + stride * POOL_SLAB_NODES;
+        pool->slab_count++;
+    }
+    void *node = pool->bump;
+    pool->bump += stride;
+    pool->total_allocs++;
+    if (++pool->in_use > pool->peak)
+        pool->peak = pool->in_use;
+    return node;
+}
+
+// Release every node at once by freeing the slabs
+void pool_release_all(Pool *pool)
+{
+    while (pool->slabs != NULL)
+    {
+        char *prev = *(char **)pool->slabs;
+        free(pool->slabs);
+        pool->slabs = prev;
+    }
+    pool->bump = pool->bump_end = NULL;
+    pool->slab_count = 0;
+    pool->in_use = 0;
+}
+
+// Print allocator statistics
+void pool_report(Pool *pool)
+{
+    printf("%-12s in use: %ld, peak: %ld, allocations: %ld, slabs: %ld (%.1f KB)\n",
+           pool->name, pool->in_use, pool->peak, pool->total_allocs, pool->slab_count,
+           pool->slab_count * (16 + pool_stride(pool) * POOL_SLAB_NODES) / 1024.0);
+}
+
+// ======================== UTILITY FUNCTIONS ========================
+
+// Generate booking ID: scrambled sequence number, unique for 36^6 bookings
+void generate_booking_id(char *id)
+{
+    int i;
+    static const char alphanum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    unsigned long long value = (booking_id_seq++ * BOOKING_ID_MULTIPLIER) % BOOKING_ID_SPACE;
+    for (i = BOOKING_ID_LEN - 1; i >= 0; i--)
+    {
+        id[i] = alphanum[value % 36];
+        value /= 36;
+    }
+    id[BOOKING_ID_LEN] = '\0';
+}
+
+// Days before each month, by leap year
+const int days_before_month[2][13] = {
+    {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+    {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}};
+
+int is_leap_year(int year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+// Date of 01/01 of a year
+Date days_before_year(int year)
+{
+    int y = year - 1, base = DATE_MIN_YEAR - 1;
+    return (year - DATE_MIN_YEAR) * 365 + (y / 4 - y / 100 + y / 400) - (base / 4 - base / 100 + base / 400);
+}
+
+// Date from day, month and year; DATE_INVALID if the fields do not name a day
+Date make_date(int day, int month, int year)
+{
+    if (year < DATE_MIN_YEAR || year > DATE_MAX_YEAR || month < 1 || month > 12)
+        return DATE_INVALID;
+    const int *before = days_before_month[is_leap_year(year)];
+    if (day < 1 || day > before[month] - before[month - 1])
+        return DATE_INVALID;
+    return days_before_year(year) + before[month - 1] + day - 1;
+}
+
+// Day, month and year of a date; all zero for DATE_INVALID
+DateParts date_parts(Date d)
+{
+    DateParts parts = {0, 0, 0};
+    if (d < 0)
+        return parts;
+    int year = DATE_MIN_YEAR + d / 365; // Overshoots by at most one year
+    if (days_before_year(year) > d)
+        year--;
+    int day_of_year = d - days_before_year(year);
+    const int *before = days_before_month[is_leap_year(year)];
+    int month = day_of_year / 31; // Never ahead, at most one month behind
+    if (day_of_year >= before[month + 1])
+        month++;
+    parts.day = day_of_year - before[month] + 1;
+    parts.month = month + 1;
+    parts.year = year;
+    return parts;
+}
+
+// Validate date
+int is_valid_date(Date d)
+{
+    return d >= days_before_year(CALENDAR_START_YEAR) && d < days_before_year(DATE_MAX_YEAR + 1);
+}
+
+// Compare dates
+int compare_dates(Date d1, Date d2)
+{
+    return d1 - d2;
+}
+
+// Calculate days between dates
+int date_diff(Date d1, Date d2)
+{
+    return d2 - d1;
+}
+
+// Write dd/mm/yyyy into out (DATE_TEXT bytes); returns out
+char *format_date(Date d, char *out)
+{
+    DateParts parts = date_parts(d);
+    if (parts.year == 0)
+        snprintf(out, DATE_TEXT, "--/--/----");
+    else
+        snprintf(out, DATE_TEXT, "%02d/%02d/%d", parts.day, parts.month, parts.year);
+    return out;
+}
+
+// Read "dd mm yyyy" from standard input
+Date read_date()
+{
+    int day, month, year;
+    if (scanf("%d %d %d", &day, &month, &year) != 3)
+        return DATE_INVALID;
+    return make_date(day, month, year);
+}
+
+// Get current date
+Date get_current_date()
+{
+    time_t t = time(NULL);
+    struct tm tm;
+    localtime_r(&t, &tm);
+    return make_date(tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
+}
+
+// Get current time
+void get_current_time(char *time_str)
+{
+    time_t now = time(NULL);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    strftime(time_str, 10, "%H:%M", &tm);
+}
+
+// ======================== ACTIVITY LOG OPERATIONS ========================
+
+// Log system activity: lock-free append; waits for the writer rather than drop
+void log_activity(char *user_id, char *action)
+{
+    unsigned long pos = atomic_load_explicit(&log_enqueue_pos, memory_order_relaxed);
+    LogRecord *slot;
+    while (1)
+    {
+        slot = &log_ring[pos & (LOG_RING_SIZE - 1)];
+        unsigned long seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        long diff = (long)(seq - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&log_enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            sched_yield(); // Ring full
+            pos = atomic_load_explicit(&log_enqueue_pos, memory_order_relaxed);
+        }
+        else
+        {
+            pos = atomic_load_explicit(&log_enqueue_pos, memory_order_relaxed);
+        }
+    }
+    strcpy(slot->user_id, user_id);
+    strcpy(slot->action, action);
+    slot->timestamp = atomic_load_explicit(&log_clock, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+// Move every published record to the log table and file; returns records written
+int drain_log_ring()
+{
+    static long cached_minute = -1;
+    static Date cached_date;
+    static char cached_time[10];
+    char date_text[DATE_TEXT];
+    unsigned long pos = atomic_load_explicit(&log_dequeue_pos, memory_order_relaxed);
+    int written = 0;
+    while (1)
+    {
+        LogRecord *slot = &log_ring[pos & (LOG_RING_SIZE - 1)];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != pos + 1)
+            break;
+        if (slot->timestamp / 60 != cached_minute)
+        {
+            time_t t = slot->timestamp;
+            struct tm tm;
+            localtime_r(&t, &tm);
+            cached_minute = slot->timestamp / 60;
+            cached_date = make_date(tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
+            strftime(cached_time, sizeof(cached_time), "%H:%M", &tm);
+        }
+        pthread_mutex_lock(&logs_lock);
+        SystemLog *log = (SystemLog *)table_push(&logs);
+        log->log_id = logs.count;
+        strcpy(log->user_id, slot->user_id);
+        strcpy(log->action, slot->action);
+        log->date = cached_date;
+        strcpy(log->time, cached_time);
+        pthread_mutex_unlock(&logs_lock);
+        if (log_file != NULL)
+            fprintf(log_file, "%d\t%s\t%s\t%s\t%s\n", log->log_id, log->user_id,
+                    log->action, format_date(log->date, date_text), log->time);
+        atomic_store_explicit(&slot->sequence, pos + LOG_RING_SIZE, memory_order_release);
+        pos++;
+        written++;
+    }
+    atomic_store_explicit(&log_dequeue_pos, pos, memory_order_release);
+    return written;
+}
+
+// Writer thread: refresh the coarse clock, batch records to disk, sync once per batch
+void *log_writer_main(void *arg)
+{
+    while (1)
+    {
+        int running = atomic_load(&log_writer_running);
+        atomic_store_explicit(&log_clock, (long)time(NULL), memory_order_relaxed);
+        if (drain_log_ring() > 0 && log_file != NULL)
+        {
+            fflush(log_file);
+            fdatasync(fileno(log_file));
+        }
+        else if (!running)
+        {
+            break;
+        }
+        else
+        {
+            usleep(LOG_IDLE_USEC);
+        }
+    }
+    return NULL;
+}
+
+// Start the background log writer
+void start_log_writer()
+{
+    int i;
+    for (i = 0; i < LOG_RING_SIZE; i++)
+        atomic_store(&log_ring[i].sequence, (unsigned long)i);
+    atomic_store(&log_clock, (long)time(NULL));
+    log_file = fopen(LOG_FILE, "a");
+    atomic_store(&log_writer_running, 1);
+    pthread_create(&log_writer, NULL, log_writer_main, NULL);
+}
+
+// Stop the writer after it has drained every queued record
+void stop_log_writer()
+{
+    atomic_store(&log_writer_running, 0);
+    pthread_join(log_writer, NULL);
+    if (log_file != NULL)
+        fclose(log_file);
+    log_file = NULL;
+}
+
+// Wait until everything logged so far is in the log table and file
+void log_flush()
+{
+    unsigned long target = atomic_load(&log_enqueue_pos);
+    while (atomic_load_explicit(&log_dequeue_pos, memory_order_acquire) < target)
+        usleep(LOG_IDLE_USEC / 2);
+}
+
+// ======================== HASH INDEX OPERATIONS ========================
+
+// FNV-1a string hash
+unsigned int hash_string(const char *key)
+{
+    unsigned int hash = 2166136261u;
+    while (*key)
+    {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Place a slot without checking for duplicates (used on insert and rehash)
+void string_index_place(StringIndex *index, IndexSlot slot)
+{
+    int mask = index->capacity - 1;
+    int i = slot.hash & mask;
+    while (index->slots[i].key != NULL)
+        i = (i + 1) & mask;
+    index->slots[i] = slot;
+}
+
+// Double the slot array and rehash using the cached hashes
+void string_index_grow(StringIndex *index)
+{
+    int i;
+    int old_capacity = index->capacity;
+    IndexSlot *old_slots = index->slots;
+    index->capacity = old_capacity ? old_capacity * 2 : 64;
+    index->slots = (IndexSlot *)calloc(index->capacity, sizeof(IndexSlot));
+    for (i = 0; i < old_capacity; i++)
+    {
+        if (old_slots[i].key != NULL)
+            string_index_place(index, old_slots[i]);
+    }
+    free(old_slots);
+}
+
+// Grow ahead of a bulk load so inserts never rehash
+void string_index_reserve(StringIndex *index, int count)
+{
+    while ((long long)count * 10 > (long long)index->capacity * 7)
+        string_index_grow(index);
+}
+
+// Find value by key
+void *string_index_find(StringIndex *index, const char *key)
+{
+    if (index->count == 0)
+        return NULL;
+    unsigned int hash = hash_string(key);
+    int mask = index->capacity - 1;
+    int i = hash & mask;
+    while (index->slots[i].key != NULL)
+    {
+        if (index->slots[i].hash == hash && strcmp(index->slots[i].key, key) == 0)
+            return index->slots[i].value;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+// Insert or replace; key must point into the record so it outlives the slot
+void string_index_insert(StringIndex *index, const char *key, void *value)
+{
+    if ((index->count + 1) * 10 > index->capacity * 7)
+        string_index_grow(index);
+    unsigned int hash = hash_string(key);
+    int mask = index->capacity - 1;
+    int i = hash & mask;
+    while (index->slots[i].key != NULL)
+    {
+        if (index->slots[i].hash == hash && strcmp(index->slots[i].key, key) == 0)
+        {
+            index->slots[i].key = key;
+            index->slots[i].value = value;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    index->slots[i].hash = hash;
+    index->slots[i].key = key;
+    index->slots[i].value = value;
+    index->count++;
+}
+
+// Remove key, shifting later probe-chain entries back so no tombstones are needed
+void string_index_remove(StringIndex *index, const char *key)
+{
+    if (index->count == 0)
+        return;
+    unsigned int hash = hash_string(key);
+    int mask = index->capacity - 1;
+    int i = hash & mask;
+    while (index->slots[i].key != NULL)
+    {
+        if (index->slots[i].hash == hash && strcmp(index->slots[i].key, key) == 0)
+            break;
+        i = (i + 1) & mask;
+    }
+    if (index->slots[i].key == NULL)
+        return;
+    int j = i;
+    while (1)
+    {
+        j = (j + 1) & mask;
+        if (index->slots[j].key == NULL)
+            break;
+        int home = index->slots[j].hash & mask;
+        // Move back unless the entry's home lies cyclically in (i, j]
+        int stays = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays)
+        {
+            index->slots[i] = index->slots[j];
+            i = j;
+        }
+    }
+    index->slots[i].key = NULL;
+    index->count--;
+}
+
+// ======================== METRICS OPERATIONS ========================
+
+// Adjust a counter or gauge
+void metric_add(atomic_long *metric, long delta)
+{
+    atomic_fetch_add_explicit(metric, delta, memory_order_relaxed);
+}
+
+long metric_get(atomic_long *metric)
+{
+    return atomic_load_explicit(metric, memory_order_relaxed);
+}
+
+// Room status, read without locks
+int room_status(int room_no)
+{
+    return __atomic_load_n(&rooms.status[room_no - 1], __ATOMIC_RELAXED);
+}
+
+// Wait out any change in progress and take the room; returns the even version taken
+unsigned int claim_room(int room_no)
+{
+    unsigned int version = atomic_load(&room_versions[room_no - 1]);
+    while ((version & 1) || !atomic_compare_exchange_weak(&room_versions[room_no - 1], &version, version + 1))
+    {
+        sched_yield();
+        version = atomic_load(&room_versions[room_no - 1]);
+    }
+    return version;
+}
+
+// Change a room's status, keeping the occupancy gauges in step
+void set_room_status(int room_no, int status)
+{
+    int old = room_status(room_no);
+    if (old == status)
+        return;
+    if (old == 1)
+        metric_add(&metrics.rooms_occupied, -1);
+    else if (old == 2)
+        metric_add(&metrics.rooms_in_maintenance, -1);
+    if (status == 1)
+        metric_add(&metrics.rooms_occupied, 1);
+    else if (status == 2)
+        metric_add(&metrics.rooms_in_maintenance, 1);
+    unsigned int version = claim_room(room_no);
+    __atomic_store_n(&rooms.status[room_no - 1], (unsigned char)status, __ATOMIC_RELAXED);
+    atomic_store(&room_versions[room_no - 1], version + 2);
+}
+
+// ======================== LINKED LIST OPERATIONS ========================
+
+// Add guest
+void add_guest_to_list(Guest **head, Guest new_guest)
+{
+    Guest *new_node = (Guest *)pool_alloc(&guest_pool);
+    strcpy(new_node->id, new_guest.id);
+    strcpy(new_node->name, new_guest.name);
+    strcpy(new_node->contact, new_guest.contact);
+    strcpy(new_node->email, new_guest.email);
+    new_node->loyalty_points = 0;
+    strcpy(new_node->preferences, "");
+    new_node->bookings = NULL;
+    new_node->next = *head;
+    *head = new_node;
+    string_index_insert(&guest_index, new_node->id, new_node);
+    guest_count++;
+}
+
+// Find guest through the ID index
+Guest *find_guest(char *id)
+{
+    return (Guest *)string_index_find(&guest_index, id);
+}
+
+// Add parking slot
+void add_parking_slot(ParkingSlot **head, int slot_no)
+{
+    ParkingSlot *new_node = (ParkingSlot *)pool_alloc(&parking_pool);
+    new_node->slot_no = slot_no;
+    new_node->status = 0;
+    strcpy(new_node->vehicle, "");
+    strcpy(new_node->guest_id, "");
+    new_node->next = *head;
+    *head = new_node;
+    parking_by_no[slot_no] = new_node;
+    parking_free[slot_no / 64] |= 1ULL << (slot_no % 64);
+}
+
+// Mark a known-free slot as occupied by a guest
+ParkingSlot *occupy_parking_slot(int slot_no, char *guest_id, char *vehicle)
+{
+    ParkingSlot *slot = parking_by_no[slot_no];
+    parking_free[slot_no / 64] &= ~(1ULL << (slot_no % 64));
+    slot->status = 1;
+    strcpy(slot->vehicle, vehicle);
+    strcpy(slot->guest_id, guest_id);
+    string_index_insert(&parking_index, slot->guest_id, slot);
+    metric_add(&metrics.parking_occupied, 1);
+    return slot;
+}
+
+// Collect up to max free slot numbers in ascending order
+int collect_free_parking(int *slot_nos, int max)
+{
+    int w, count = 0;
+    for (w = 0; w < PARKING_WORDS && count < max; w++)
+    {
+        unsigned long long bits = parking_free[w];
+        while (bits != 0 && count < max)
+        {
+            slot_nos[count++] = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+        }
+    }
+    return count;
+}
+
+// Take the lowest-numbered free slot for a guest, or NULL if the lot is full
+ParkingSlot *allocate_parking_slot(char *guest_id, char *vehicle)
+{
+    int slot_no;
+    if (collect_free_parking(&slot_no, 1) == 0)
+        return NULL;
+    return occupy_parking_slot(slot_no, guest_id, vehicle);
+}
+
+// Release parking slot
+void release_parking_slot(int slot_no)
+{
+    ParkingSlot *slot = parking_by_no[slot_no];
+    if (slot == NULL || slot->status != 1)
+        return;
+    string_index_remove(&parking_index, slot->guest_id);
+    slot->status = 0;
+    strcpy(slot->vehicle, "");
+    strcpy(slot->guest_id, "");
+    parking_free[slot_no / 64] |= 1ULL << (slot_no % 64);
+    metric_add(&metrics.parking_occupied, -1);
+}
+
+// Find the slot a guest currently holds
+ParkingSlot *find_guest_parking(char *guest_id)
+{
+    return (ParkingSlot *)string_index_find(&parking_index, guest_id);
+}
+
+// Add to parking waitlist; returns 0 when the ring is full
+int add_to_waitlist(char *vehicle, char *guest_id)
+{
+    if (waitlist_tail - waitlist_head == MAX_WAITLIST)
+        return 0;
+    WaitlistEntry *entry = &parking_waitlist[waitlist_tail % MAX_WAITLIST];
+    strcpy(entry->vehicle, vehicle);
+    strcpy(entry->guest_id, guest_id);
+    waitlist_tail++;
+    return 1;
+}
+
+// Check whether a guest is queued; the ring holds at most MAX_WAITLIST entries
+int in_waitlist(const char *guest_id)
+{
+    unsigned int pos;
+    for (pos = waitlist_head; pos != waitlist_tail; pos++)
+    {
+        if (strcmp(parking_waitlist[pos % MAX_WAITLIST].guest_id, guest_id) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+// Remove from waitlist (oldest first)
+WaitlistEntry *remove_from_waitlist()
+{
+    if (waitlist_head == waitlist_tail)
+        return NULL;
+    return &parking_waitlist[waitlist_head++ % MAX_WAITLIST];
+}
+
+// ======================== BINARY TREE OPERATIONS ========================
+
+// Create new booking node
+BookingNode *new_booking_node(char *guest_id, int room_no, int parking_slot,
+                              int facility_id, Date ci, Date co, float total)
+{
+    BookingNode *node = (BookingNode *)pool_alloc(&booking_pool);
+    generate_booking_id(node->booking_id);
+    strcpy(node->guest_id, guest_id);
+    node->room_no = room_no;
+    node->parking_slot = parking_slot;
+    node->facility_id = facility_id;
+    node->check_in = ci;
+    node->check_out = co;
+    node->total = total;
+    node->service_charges = 0;
+    node->status = 0;
+    node->height = 1;
+    node->left = node->right = NULL;
+    node->next_for_guest = NULL;
+    string_index_insert(&booking_index, node->booking_id, node);
+    metric_add(&metrics.bookings_upcoming, 1);
+    Guest *guest = find_guest(guest_id);
+    if (guest != NULL)
+    {
+        BookingNode **link = &guest->bookings;
+        while (*link != NULL && compare_dates((*link)->check_in, ci) <= 0)
+            link = &(*link)->next_for_guest;
+        node->next_for_guest = *link;
+        *link = node;
+    }
+    booking_count++;
+    return node;
+}
+
+// Height of booking subtree
+int booking_height(BookingNode *node)
+{
+    return node == NULL ? 0 : node->height;
+}
+
+// Recompute node height from its children
+void update_booking_height(BookingNode *node)
+{
+    int left = booking_height(node->left);
+    int right = booking_height(node->right);
+    node->height = (left > right ? left : right) + 1;
+}
+
+// Rotate subtree right
+BookingNode *rotate_booking_right(BookingNode *node)
+{
+    BookingNode *pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update_booking_height(node);
+    update_booking_height(pivot);
+    return pivot;
+}
+
+// Rotate subtree left
+BookingNode *rotate_booking_left(BookingNode *node)
+{
+    BookingNode *pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update_booking_height(node);
+    update_booking_height(pivot);
+    return pivot;
+}
+
+// Insert booking (AVL, ordered by check-in; equal dates go right)
+BookingNode *insert_booking(BookingNode *node, BookingNode *new_node)
+{
+    if (node == NULL)
+        return new_node;
+    int date_compare = compare_dates(new_node->check_in, node->check_in);
+    if (date_compare < 0)
+    {
+        node->left = insert_booking(node->left, new_node);
+    }
+    else
+    {
+        node->right = insert_booking(node->right, new_node);
+    }
+    update_booking_height(node);
+    int balance = booking_height(node->left) - booking_height(node->right);
+    if (balance > 1)
+    {
+        if (booking_height(node->left->left) < booking_height(node->left->right))
+            node->left = rotate_booking_left(node->left);
+        return rotate_booking_right(node);
+    }
+    if (balance < -1)
+    {
+        if (booking_height(node->right->right) < booking_height(node->right->left))
+            node->right = rotate_booking_right(node->right);
+        return rotate_booking_left(node);
+    }
+    return node;
+}
+
+// Build a balanced tree from bookings already sorted by check-in
+BookingNode *build_booking_tree(BookingNode *sorted, long long lo, long long hi)
+{
+    if (lo > hi)
+        return NULL;
+    long long mid = lo + (hi - lo) / 2;
+    BookingNode *node = &sorted[mid];
+    node->left = build_booking_tree(sorted, lo, mid - 1);
+    node->right = build_booking_tree(sorted, mid + 1, hi);
+    update_booking_height(node);
+    return node;
+}
+
+// Visit bookings with from <= check-in <= to, in check-in order
+void scan_bookings(BookingNode *root, Date from, Date to,
+                   void (*visit)(BookingNode *, void *), void *ctx)
+{
+    if (root == NULL)
+        return;
+    int after_from = compare_dates(root->check_in, from) >= 0;
+    int before_to = compare_dates(root->check_in, to) <= 0;
+    if (after_from)
+        scan_bookings(root->left, from, to, visit, ctx);
+    if (after_from && before_to)
+        visit(root, ctx);
+    if (before_to)
+        scan_bookings(root->right, from, to, visit, ctx);
+}
+
+// Print a guest's booking history
+void search_bookings_by_guest(Guest *guest)
+{
+    BookingNode *booking;
+    char *status_str[] = {"Upcoming", "Active", "Completed", "Cancelled"};
+    char date_text[DATE_TEXT];
+    for (booking = guest->bookings; booking != NULL; booking = booking->next_for_guest)
+    {
+        printf("Booking ID: %s, Room %d, Check-in: %s, Status: %s\n",
+               booking->booking_id, booking->room_no, format_date(booking->check_in, date_text),
+               status_str[booking->status]);
+    }
+}
+
+// Find booking through the ID index
+BookingNode *find_booking(char *booking_id)
+{
+    return (BookingNode *)string_index_find(&booking_index, booking_id);
+}
+
+// Attach a parking slot to the guest's first booking that has not completed
+void link_parking_to_booking(char *guest_id, int slot_no)
+{
+    Guest *guest = find_guest(guest_id);
+    BookingNode *booking;
+    if (guest == NULL)
+        return;
+    for (booking = guest->bookings; booking != NULL; booking = booking->next_for_guest)
+    {
+        if (booking->status < 2 && booking->room_no != -1)
+        {
+            booking->parking_slot = slot_no;
+            return;
+        }
+    }
+}
+
+// ======================== CALENDAR OPERATIONS ========================
+
+// Day index since 01/01/CALENDAR_START_YEAR
+int calendar_day(Date d)
+{
+    return d - days_before_year(CALENDAR_START_YEAR);
+}
+
+// Rooms free for every night in [ci, co), one bit per room
+void find_free_rooms(Date ci, Date co, unsigned long long free_rooms[ROOM_WORDS])
+{
+    int day, w;
+    unsigned long long booked[ROOM_WORDS] = {0};
+    int first = calendar_day(ci), last = calendar_day(co);
+    for (day = first; day < last; day++)
+    {
+        for (w = 0; w < ROOM_WORDS; w++)
+            booked[w] |= atomic_load_explicit(&room_calendar[day][w], memory_order_relaxed);
+    }
+    for (w = 0; w < ROOM_WORDS; w++)
+        free_rooms[w] = ~booked[w];
+    if (MAX_ROOMS % 64)
+        free_rooms[ROOM_WORDS - 1] &= (1ULL << (MAX_ROOMS % 64)) - 1;
+    for (w = 0; w < MAX_ROOMS; w++)
+    {
+        if (room_status(w + 1) == 2)
+            free_rooms[w / 64] &= ~(1ULL << (w % 64));
+    }
+}
+
+// Check a room's bit in a room mask
+int room_in_mask(const unsigned long long mask[ROOM_WORDS], int room_no)
+{
+    return (mask[(room_no - 1) / 64] >> ((room_no - 1) % 64)) & 1;
+}
+
+// Check one room is bookable for every night in [ci, co)
+int room_is_free(int room_no, Date ci, Date co)
+{
+    int day;
+    int last = calendar_day(co);
+    unsigned long long bit = 1ULL << ((room_no - 1) % 64);
+    if (room_status(room_no) == 2)
+        return 0;
+    for (day = calendar_day(ci); day < last; day++)
+    {
+        if (atomic_load_explicit(&room_calendar[day][(room_no - 1) / 64], memory_order_relaxed) & bit)
+            return 0;
+    }
+    return 1;
+}
+
+// Mark nights [ci, co) as booked for a room; all or nothing, so a night already taken undoes the rest
+int take_room_nights(int room_no, Date ci, Date co)
+{
+    int day, first = calendar_day(ci), last = calendar_day(co);
+    unsigned long long bit = 1ULL << ((room_no - 1) % 64);
+    for (day = first; day < last; day++)
+    {
+        if (atomic_fetch_or_explicit(&room_calendar[day][(room_no - 1) / 64], bit, memory_order_relaxed) & bit)
+            break;
+    }
+    if (day == last)
+        return 1;
+    while (--day >= first)
+        atomic_fetch_and_explicit(&room_calendar[day][(room_no - 1) / 64], ~bit, memory_order_relaxed);
+    return 0;
+}
+
+// Lock-free availability check; *version is the room version the answer holds for
+int check_room_availability(int room_no, Date ci, Date co, unsigned int *version)
+{
+    int free;
+    unsigned int before;
+    do
+    {
+        before = atomic_load(&room_versions[room_no - 1]);
+        free = !(before & 1) && room_is_free(room_no, ci, co);
+    } while ((before & 1) || atomic_load(&room_versions[room_no - 1]) != before);
+    *version = before;
+    return free;
+}
+
+// Reserve a stay if the room is unchanged since the caller's check. No mutex is held: the CAS
+// to an odd version is the room-level gate, and a conflicting commit fails fast instead of waiting.
+// Without a prior check there is nothing to be stale, so the room is claimed by waiting instead.
+OpStatus commit_room_nights(int room_no, Date ci, Date co, unsigned int version)
+{
+    int replay = version == ROOM_REPLAYED;
+    if (version == ROOM_UNCHECKED || replay)
+        version = claim_room(room_no);
+    else if ((version & 1) || !atomic_compare_exchange_strong(&room_versions[room_no - 1], &version, version + 1))
+        return ST_ROOM_CHANGED;
+    if ((!replay && room_status(room_no) == 2) || !take_room_nights(room_no, ci, co))
+    {
+        atomic_store(&room_versions[room_no - 1], version);
+        return ST_ROOM_UNAVAILABLE;
+    }
+    atomic_store(&room_versions[room_no - 1], version + 2);
+    return ST_OK;
+}
+
+// Give back nights taken by commit_room_nights
+void cancel_room_nights(int room_no, Date ci, Date co)
+{
+    int day, last = calendar_day(co);
+    unsigned long long bit = 1ULL << ((room_no - 1) % 64);
+    unsigned int version = claim_room(room_no);
+    for (day = calendar_day(ci); day < last; day++)
+        atomic_fetch_and_explicit(&room_calendar[day][(room_no - 1) / 64], ~bit, memory_order_relaxed);
+    atomic_store(&room_versions[room_no - 1], version + 2);
+}
+
+// ======================== FACILITY SLOT OPERATIONS ========================
+
+// Page holding a facility's day (facility is an index into facilities); NULL if never booked
+SlotPage *slot_page(int facility, int day, int allocate)
+{
+    SlotPage **page = &slot_pages[facility * SLOT_PAGES + day / SLOT_PAGE_DAYS];
+    if (*page == NULL && allocate)
+        *page = (SlotPage *)calloc(1, sizeof(SlotPage));
+    return *page;
+}
+
+// Bits for count slots starting at slot
+unsigned long long slot_mask(int slot, int count)
+{
+    return ((1ULL << count) - 1) << slot;
+}
+
+// Slots of a day with no capacity left
+unsigned long long full_slots(int facility, Date d)
+{
+    int day = calendar_day(d);
+    SlotPage *page = slot_page(facility, day, 0);
+    return page != NULL ? page->full[day % SLOT_PAGE_DAYS] : 0;
+}
+
+// Check a run of slots lies within one day
+int valid_slot_range(int slot, int count)
+{
+    return slot >= 0 && count >= 1 && slot + count <= SLOTS_PER_DAY;
+}
+
+// Check every slot in a run has a place left; one mask test whatever the capacity
+int slots_free(int facility, Date d, int slot, int count)
+{
+    return (full_slots(facility, d) & slot_mask(slot, count)) == 0;
+}
+
+// Take one place in each slot of a run, marking slots that reach capacity as full
+void reserve_slots(int facility, Date d, int slot, int count)
+{
+    int i, day = calendar_day(d);
+    SlotPage *page = slot_page(facility, day, 1);
+    unsigned char *booked = page->booked[day % SLOT_PAGE_DAYS];
+    for (i = slot; i < slot + count; i++)
+    {
+        if (++booked[i] >= facilities[facility].capacity)
+            page->full[day % SLOT_PAGE_DAYS] |= 1ULL << i;
+    }
+}
+
+// Slot boundary as HH:MM; SLOTS_PER_DAY is 24:00
+char *format_slot(int slot, char *text)
+{
+    int minutes = slot >= 0 && slot <= SLOTS_PER_DAY ? slot * SLOT_MINUTES : 0;
+    snprintf(text, SLOT_TEXT, "%02d:%02d", minutes / 60, minutes % 60);
+    return text;
+}
+
+// Slot containing an HH:MM time of day; -1 if invalid
+int parse_slot_time(const char *text)
+{
+    int hours, minutes;
+    if (sscanf(text, "%d:%d", &hours, &minutes) != 2 || hours < 0 || hours > 23 ||
+        minutes < 0 || minutes > 59)
+        return -1;
+    return (hours * 60 + minutes) / SLOT_MINUTES;
+}
+
+// Slots needed to cover a duration
+int slots_for_minutes(int minutes)
+{
+    return minutes > 0 ? (minutes + SLOT_MINUTES - 1) / SLOT_MINUTES : 0;
+}
+
+// Free time ranges of a day, e.g. "08:00-12:30,14:00-24:00"; each range is two bit scans
+char *format_free_slots(int facility, Date d, char *text, size_t size)
+{
+    unsigned long long free = ~full_slots(facility, d) & DAY_SLOTS;
+    size_t used = 0;
+    char from[SLOT_TEXT], to[SLOT_TEXT];
+    snprintf(text, size, "none");
+    while (free != 0 && used < size)
+    {
+        int start = __builtin_ctzll(free);
+        int length = __builtin_ctzll(~(free >> start));
+        used += snprintf(text + used, size - used, "%s%s-%s", used > 0 ? "," : "",
+                         format_slot(start, from), format_slot(start + length, to));
+        free &= ~slot_mask(start, length);
+    }
+    return text;
+}
+
+// Print a facility's free time ranges for each of a run of days
+void print_free_slots(int facility, Date from, int days)
+{
+    int i;
+    char text[FREE_SLOTS_TEXT], date_text[DATE_TEXT];
+    printf("Free times at %s:\n", facilities[facility].name);
+    for (i = 0; i < days && is_valid_date(from + i); i++)
+        printf("%s  %s\n", format_date(from + i, date_text),
+               format_free_slots(facility, from + i, text, sizeof(text)));
+}
+
+// ======================== ROOM SEARCH OPERATIONS ========================
+
+// Bit for a feature name, adding it to the dictionary if new; -1 if the dictionary is full
+int intern_feature(const char *name)
+{
+    int i;
+    for (i = 0; i < rooms.feature_count; i++)
+    {
+        if (strcasecmp(rooms.feature_names[i], name) == 0)
+            return i;
+    }
+    if (rooms.feature_count == MAX_FEATURES)
+        return -1;
+    snprintf(rooms.feature_names[rooms.feature_count], FEATURE_NAME, "%s", name);
+    return rooms.feature_count++;
+}
+
+// Parse a comma-separated feature list into a mask; 0 on an unknown name unless interning
+int parse_features(const char *list, unsigned int *mask, int intern)
+{
+    char copy[200];
+    int i;
+    *mask = 0;
+    snprintf(copy, sizeof(copy), "%s", list);
+    char *name = strtok(copy, ",");
+    while (name != NULL)
+    {
+        while (isspace((unsigned char)*name))
+            name++;
+        char *end = name + strlen(name);
+        while (end > name && isspace((unsigned char)end[-1]))
+            *--end = '\0';
+        int bit = -1;
+        if (intern)
+        {
+            bit = intern_feature(name);
+        }
+        else
+        {
+            for (i = 0; i < rooms.feature_count && bit < 0; i++)
+            {
+                if (strcasecmp(rooms.feature_names[i], name) == 0)
+                    bit = i;
+            }
+        }
+        if (bit < 0)
+        {
+            printf("Unknown feature: %s\n", name);
+            return 0;
+        }
+        *mask |= 1u << bit;
+        name = strtok(NULL, ",");
+    }
+    return 1;
+}
+
+// Replace a room's features and keep the per-feature bitmaps in step
+void set_room_features(int room_no, const char *list)
+{
+    int f;
+    unsigned int mask;
+    parse_features(list, &mask, 1);
+    for (f = 0; f < MAX_FEATURES; f++)
+    {
+        unsigned long long bit = 1ULL << ((room_no - 1) % 64);
+        if (mask & (1u << f))
+            rooms.feature_rooms[f][(room_no - 1) / 64] |= bit;
+        else
+            rooms.feature_rooms[f][(room_no - 1) / 64] &= ~bit;
+    }
+    rooms.features[room_no - 1] = mask;
+}
+
+// Feature names in a mask, comma-separated
+void format_features(unsigned int mask, char *out, size_t size)
+{
+    int f;
+    size_t used = 0;
+    out[0] = '\0';
+    for (f = 0; f < rooms.feature_count && used < size; f++)
+    {
+        if (mask & (1u << f))
+            used += snprintf(out + used, size - used, "%s%s", used ? ", " : "", rooms.feature_names[f]);
+    }
+}
+
+// Rooms matching a filter, one bit per room; 16 rooms per step with SSE2
+void filter_rooms(const RoomFilter *filter, unsigned long long matches[ROOM_WORDS])
+{
+    int i;
+    int floor_min = filter->floor_min > 0 ? filter->floor_min : 0;
+    int floor_max = filter->floor_max > 0 ? filter->floor_max : 255;
+    float price_max = filter->price_max > 0 ? filter->price_max : 3.4e38f;
+    memset(matches, 0, ROOM_WORDS * sizeof(unsigned long long));
+#ifdef __SSE2__
+    __m128i maintenance = _mm_set1_epi8(2);
+    __m128i type = _mm_set1_epi8((char)filter->type);
+    __m128i low = _mm_set1_epi8((char)floor_min);
+    __m128i high = _mm_set1_epi8((char)floor_max);
+    __m128i capacity = _mm_set1_epi8((char)filter->capacity_min);
+    __m128 price = _mm_set1_ps(price_max);
+    for (i = 0; i < ROOM_SLOTS; i += 16)
+    {
+        __m128i floors = _mm_loadu_si128((const __m128i *)&rooms.floor[i]);
+        __m128i caps = _mm_loadu_si128((const __m128i *)&rooms.capacity[i]);
+        // Unsigned x >= y is max(x, y) == x; x <= y is min(x, y) == x
+        __m128i ok = _mm_andnot_si128(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&rooms.status[i]), maintenance),
+            _mm_cmpeq_epi8(_mm_max_epu8(floors, low), floors));
+        ok = _mm_and_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(floors, high), floors));
+        ok = _mm_and_si128(ok, _mm_cmpeq_epi8(_mm_max_epu8(caps, capacity), caps));
+        if (filter->type != 0)
+            ok = _mm_and_si128(ok, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&rooms.type[i]), type));
+        unsigned int bits = _mm_movemask_epi8(ok);
+        unsigned int cheap = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&rooms.price[i]), price)) |
+                             _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&rooms.price[i + 4]), price)) << 4 |
+                             _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&rooms.price[i + 8]), price)) << 8 |
+                             _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&rooms.price[i + 12]), price)) << 12;
+        matches[i / 64] |= (unsigned long long)(bits & cheap) << (i % 64);
+    }
+#else
+    for (i = 0; i < MAX_ROOMS; i++)
+    {
+        if (rooms.status[i] != 2 && rooms.floor[i] >= floor_min && rooms.floor[i] <= floor_max &&
+            rooms.capacity[i] >= filter->capacity_min && rooms.price[i] <= price_max &&
+            (filter->type == 0 || rooms.type[i] == filter->type))
+            matches[i / 64] |= 1ULL << (i % 64);
+    }
+#endif
+    if (MAX_ROOMS % 64)
+        matches[ROOM_WORDS - 1] &= (1ULL << (MAX_ROOMS % 64)) - 1;
+    // Feature predicates combine the per-feature bitmaps word by word
+    int f, w;
+    for (f = 0; f < rooms.feature_count; f++)
+    {
+        if (filter->features_all & (1u << f))
+        {
+            for (w = 0; w < ROOM_WORDS; w++)
+                matches[w] &= rooms.feature_rooms[f][w];
+        }
+    }
+    if (filter->features_any != 0)
+    {
+        unsigned long long any[ROOM_WORDS] = {0};
+        for (f = 0; f < rooms.feature_count; f++)
+        {
+            if (filter->features_any & (1u << f))
+            {
+                for (w = 0; w < ROOM_WORDS; w++)
+                    any[w] |= rooms.feature_rooms[f][w];
+            }
+        }
+        for (w = 0; w < ROOM_WORDS; w++)
+            matches[w] &= any[w];
+    }
+}
+
+// Print the rooms in a mask; returns how many were listed
+int print_rooms(const unsigned long long mask[ROOM_WORDS])
+{
+    int i, listed = 0;
+    char features[200];
+    printf("Room No\tType\tFloor\tCapacity\tPrice\tFeatures\n");
+    for (i = 0; i < MAX_ROOMS; i++)
+    {
+        if (room_in_mask(mask, i + 1))
+        {
+            char *type = (rooms.type[i] == 1) ? "Standard" : (rooms.type[i] == 2) ? "Deluxe"
+                                                                                  : "Suite";
+            format_features(rooms.features[i], features, sizeof(features));
+            printf("%d\t%s\t%d\t%d\t\t$%.2f\t%s\n",
+                   i + 1, type, rooms.floor[i], rooms.capacity[i],
+                   rooms.price[i], features);
+            listed++;
+        }
+    }
+    return listed;
+}
+
+// ======================== ROLLUP OPERATIONS ========================
+
+// Bucket for a day and room (-1 for facilities and other charges); month pages are allocated on first use.
+// NULL for a date outside the calendar.
+RollupBucket *rollup_bucket(Date d, int room_no, int day_level)
+{
+    DateParts parts = date_parts(d);
+    int month = (parts.year - CALENDAR_START_YEAR) * 12 + parts.month - 1;
+    if (month < 0 || month >= CALENDAR_MONTHS)
+        return NULL;
+    if (rollup_pages[month] == NULL)
+    {
+        rollup_pages[month] = (RollupPage *)calloc(1, sizeof(RollupPage));
+        rollup_pages[month]->month = month;
+    }
+    int type = room_no == -1 ? 0 : rooms.type[room_no - 1];
+    int floor = room_no == -1 ? 0 : rooms.floor[room_no - 1];
+    if (day_level)
+        return &rollup_pages[month]->days[parts.day - 1][type][floor];
+    return &rollup_pages[month]->total[type][floor];
+}
+
+// Add to a day's bucket and its month total
+void rollup_add(Date d, int room_no, float revenue, float room_sales, int room_nights)
+{
+    RollupBucket *buckets[2] = {rollup_bucket(d, room_no, 1), rollup_bucket(d, room_no, 0)};
+    int i;
+    if (buckets[0] == NULL || buckets[1] == NULL)
+        return;
+    for (i = 0; i < 2; i++)
+    {
+        buckets[i]->revenue += revenue;
+        buckets[i]->room_sales += room_sales;
+        buckets[i]->room_nights += room_nights;
+    }
+}
+
+// Spread a room booking's nights and rate over the nights it covers
+void rollup_booking(BookingNode *booking)
+{
+    int nights = date_diff(booking->check_in, booking->check_out);
+    int i;
+    if (booking->room_no == -1 || nights <= 0)
+        return;
+    pthread_mutex_lock(&rollup_lock);
+    for (i = 0; i < nights; i++)
+        rollup_add(booking->check_in + i, booking->room_no, 0, booking->total / nights, 1);
+    pthread_mutex_unlock(&rollup_lock);
+}
+
+// Recognise a paid bill on the day it was paid
+void rollup_payment(Bill *bill, Date paid)
+{
+    BookingNode *booking = find_booking(bill->booking_id);
+    pthread_mutex_lock(&rollup_lock);
+    rollup_add(paid, booking != NULL ? booking->room_no : -1, bill->total, 0, 0);
+    pthread_mutex_unlock(&rollup_lock);
+}
+
+// Merge pre-aggregated buckets for one day, a month (day 0) or a year (month 0)
+void rollup_query(DateParts period, RollupBucket out[ROLLUP_TYPES][ROLLUP_FLOORS])
+{
+    int m, t, f;
+    memset(out, 0, sizeof(RollupBucket) * ROLLUP_TYPES * ROLLUP_FLOORS);
+    int first = (period.year - CALENDAR_START_YEAR) * 12 + (period.month ? period.month - 1 : 0);
+    int last = period.month ? first : first + 11;
+    pthread_mutex_lock(&rollup_lock);
+    for (m = first; m <= last; m++)
+    {
+        RollupPage *page = rollup_pages[m];
+        if (page == NULL)
+            continue;
+        RollupBucket (*cells)[ROLLUP_FLOORS] = period.day ? page->days[period.day - 1] : page->total;
+        for (t = 0; t < ROLLUP_TYPES; t++)
+        {
+            for (f = 0; f < ROLLUP_FLOORS; f++)
+            {
+                out[t][f].revenue += cells[t][f].revenue;
+                out[t][f].room_sales += cells[t][f].room_sales;
+                out[t][f].room_nights += cells[t][f].room_nights;
+            }
+        }
+    }
+    pthread_mutex_unlock(&rollup_lock);
+}
+
+// Days covered by a report period
+int period_days(DateParts period)
+{
+    if (period.day)
+        return 1;
+    if (period.month)
+        return days_before_month[is_leap_year(period.year)][period.month] -
+               days_before_month[is_leap_year(period.year)][period.month - 1];
+    return 365 + is_leap_year(period.year);
+}
+
+// Print revenue, room-nights, ADR and occupancy by room type and floor
+void print_rollup_report(DateParts period)
+{
+    RollupBucket cells[ROLLUP_TYPES][ROLLUP_FLOORS];
+    int room_counts[ROLLUP_TYPES][ROLLUP_FLOORS] = {{0}};
+    int t, f, i;
+    char *types[] = {"Other", "Standard", "Deluxe", "Suite"};
+    rollup_query(period, cells);
+    for (i = 0; i < MAX_ROOMS; i++)
+        room_counts[rooms.type[i]][rooms.floor[i]]++;
+    int days = period_days(period);
+    RollupBucket total = {0};
+    int total_rooms = 0;
+    printf("Type\t\tFloor\tRevenue\t\tRoom-nights\tADR\tOccupancy\n");
+    for (t = 0; t < ROLLUP_TYPES; t++)
+    {
+        for (f = 0; f < ROLLUP_FLOORS; f++)
+        {
+            RollupBucket *cell = &cells[t][f];
+            total.revenue += cell->revenue;
+            total.room_sales += cell->room_sales;
+            total.room_nights += cell->room_nights;
+            total_rooms += room_counts[t][f];
+            if (cell->revenue == 0 && cell->room_nights == 0)
+                continue;
+            if (t == 0)
+            {
+                printf("%-12s\t-\t$%.2f\n", types[t], cell->revenue);
+                continue;
+            }
+            printf("%-12s\t%d\t$%.2f\t%d\t\t$%.2f\t%.2f%%\n", types[t], f, cell->revenue,
+                   cell->room_nights, cell->room_nights ? cell->room_sales / cell->room_nights : 0,
+                   room_counts[t][f] ? 100.0 * cell->room_nights / (room_counts[t][f] * days) : 0);
+        }
+    }
+    printf("%-12s\t\t$%.2f\t%d\t\t$%.2f\t%.2f%%\n", "Total", total.revenue, total.room_nights,
+           total.room_nights ? total.room_sales / total.room_nights : 0,
+           100.0 * total.room_nights / (total_rooms * days));
+}
+
+// ======================== TIMER HEAP OPERATIONS ========================
+
+// Heap ordering: earlier day first, check-outs before check-ins
+int booking_event_before(BookingEvent a, BookingEvent b)
+{
+    if (a.day != b.day)
+        return a.day < b.day;
+    return a.type < b.type;
+}
+
+// Push a transition onto the heap
+void push_booking_event(int day, int type, BookingNode *booking)
+{
+    if (booking_event_count == booking_event_capacity)
+    {
+        booking_event_capacity = booking_event_capacity ? booking_event_capacity * 2 : 64;
+        booking_events = (BookingEvent *)realloc(booking_events,
+                                                 booking_event_capacity * sizeof(BookingEvent));
+    }
+    BookingEvent event = {day, type, booking};
+    int i = booking_event_count++;
+    while (i > 0 && booking_event_before(event, booking_events[(i - 1) / 2]))
+    {
+        booking_events[i] = booking_events[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    booking_events[i] = event;
+}
+
+// Pop the earliest transition
+BookingEvent pop_booking_event()
+{
+    BookingEvent top = booking_events[0];
+    BookingEvent last = booking_events[--booking_event_count];
+    int i = 0;
+    while (2 * i + 1 < booking_event_count)
+    {
+        int child = 2 * i + 1;
+        if (child + 1 < booking_event_count &&
+            booking_event_before(booking_events[child + 1], booking_events[child]))
+            child++;
+        if (!booking_event_before(booking_events[child], last))
+            break;
+        booking_events[i] = booking_events[child];
+        i = child;
+    }
+    booking_events[i] = last;
+    return top;
+}
+
+// Schedule a new booking's check-in; its check-out is queued when check-in fires
+void schedule_booking(BookingNode *booking)
+{
+    push_booking_event(calendar_day(booking->check_in), 1, booking);
+}
+
+// Fire every transition due by the given date
+void process_due_bookings(Date current)
+{
+    int today = calendar_day(current);
+    while (booking_event_count > 0 && booking_events[0].day <= today)
+    {
+        BookingEvent event = pop_booking_event();
+        BookingNode *booking = event.booking;
+        if (event.type == 1 && booking->status == 0)
+        {
+            booking->status = 1;
+            metric_add(&metrics.bookings_upcoming, -1);
+            metric_add(&metrics.bookings_active, 1);
+            if (booking->room_no != -1)
+            {
+                room_occupant[booking->room_no - 1] = booking;
+                if (room_status(booking->room_no) == 0)
+                    set_room_status(booking->room_no, 1);
+            }
+            push_booking_event(calendar_day(booking->check_out), 0, booking);
+        }
+        else if (event.type == 0 && booking->status == 1)
+        {
+            booking->status = 2;
+            metric_add(&metrics.bookings_active, -1);
+            metric_add(&metrics.bookings_completed, 1);
+            if (booking->room_no != -1)
+            {
+                if (room_occupant[booking->room_no - 1] == booking)
+                    room_occupant[booking->room_no - 1] = NULL;
+                if (room_status(booking->room_no) == 1)
+                    set_room_status(booking->room_no, 0);
+            }
+            if (booking->parking_slot != -1)
+                release_parking_slot(booking->parking_slot);
+        }
+    }
+}
+
+// ======================== GRAPH OPERATIONS ========================
+
+// Used when FACILITY_FILE is absent; floors are added and linked by lifts automatically
+const char *default_facility_config =
+    "facility\tGym\tgym\t10\t12\n"
+    "facility\tPool\tpool\t5\t20\n"
+    "facility\tSpa\tspa\t50\t2\n"
+    "facility\tRestaurant\trestaurant\t0\t40\n"
+    "facility\tConference Room\tconference\t100\t1\n"
+    "path\tGym\tPool\t40\n"
+    "path\tGym\tSpa\t60\n"
+    "path\tPool\tRestaurant\t80\n"
+    "path\tSpa\tRestaurant\t50\n"
+    "path\tRestaurant\tConference Room\t30\n"
+    "path\tFloor 1\tRestaurant\t20\n"
+    "path\tFloor 1\tGym\t50\n";
+
+// Graph node by name: a facility, or "Floor N"; -1 if unknown
+int graph_node(const char *name)
+{
+    int i, floor;
+    for (i = 0; i < facility_count; i++)
+    {
+        if (strcasecmp(facilities[i].name, name) == 0)
+            return i;
+    }
+    if (sscanf(name, "Floor %d", &floor) == 1 && floor >= 1 && floor <= FLOORS)
+        return facility_count + floor - 1;
+    return -1;
+}
+
+// Node where walks from a room start
+int room_node(int room_no)
+{
+    return facility_count + rooms.floor[room_no - 1] - 1;
+}
+
+int compare_facility_distance(const void *a, const void *b)
+{
+    const FacilityDistance *x = (const FacilityDistance *)a, *y = (const FacilityDistance *)b;
+    return (x->metres > y->metres) - (x->metres < y->metres);
+}
+
+// Load facilities and walking paths, then precompute all-pairs distances (Floyd-Warshall)
+// and, for every node, the facilities ordered nearest first
+void init_facility_graph(const char *path)
+{
+    FILE *config = fopen(path, "r");
+    if (config == NULL)
+        config = fmemopen((void *)default_facility_config, strlen(default_facility_config), "r");
+    char line[BATCH_LINE];
+    int pass, i, j, k;
+    for (pass = 0; pass < 2; pass++)
+    {
+        rewind(config);
+        while (fgets(line, sizeof(line), config) != NULL)
+        {
+            char *save, *fields[5];
+            int count = 0;
+            if (line[0] == '#')
+                continue;
+            for (fields[0] = strtok_r(line, "\t\r\n", &save); fields[count] != NULL && count < 4;)
+                fields[++count] = strtok_r(NULL, "\t\r\n", &save);
+            if (count < 3 || fields[3] == NULL)
+                continue;
+            if (pass == 0 && strcmp(fields[0], "facility") == 0)
+            {
+                facilities = (Facility *)realloc(facilities, (facility_count + 1) * sizeof(Facility));
+                Facility *facility = &facilities[facility_count++];
+                memset(facility, 0, sizeof(*facility));
+                facility->facility_id = facility_count;
+                snprintf(facility->name, sizeof(facility->name), "%s", fields[1]);
+                snprintf(facility->kind, sizeof(facility->kind), "%s", fields[2]);
+                facility->booking_fee = atof(fields[3]);
+                facility->capacity = count == 4 && fields[4] != NULL ? atoi(fields[4]) : 1;
+                if (facility->capacity < 1 || facility->capacity > MAX_FACILITY_CAPACITY)
+                    facility->capacity = facility->capacity < 1 ? 1 : MAX_FACILITY_CAPACITY;
+            }
+            else if (pass == 1 && strcmp(fields[0], "path") == 0)
+            {
+                int from = graph_node(fields[1]), to = graph_node(fields[2]);
+                float metres = atof(fields[3]);
+                if (from < 0 || to < 0 || metres < 0)
+                {
+                    printf("Warning: ignoring path %s - %s in %s\n", fields[1], fields[2], path);
+                    continue;
+                }
+                if (metres < graph_distance[from * graph_nodes + to])
+                    graph_distance[from * graph_nodes + to] = graph_distance[to * graph_nodes + from] = metres;
+            }
+        }
+        if (pass == 0)
+        {
+            slot_pages = (SlotPage **)calloc((size_t)facility_count * SLOT_PAGES, sizeof(SlotPage *));
+            graph_nodes = facility_count + FLOORS;
+            graph_distance = (float *)malloc(sizeof(float) * graph_nodes * graph_nodes);
+            for (i = 0; i < graph_nodes; i++)
+            {
+                for (j = 0; j < graph_nodes; j++)
+                    graph_distance[i * graph_nodes + j] = i == j ? 0 : INFINITY;
+            }
+            for (i = 1; i < FLOORS; i++)
+            {
+                int lower = facility_count + i - 1;
+                graph_distance[lower * graph_nodes + lower + 1] = FLOOR_LIFT_METRES;
+                graph_distance[(lower + 1) * graph_nodes + lower] = FLOOR_LIFT_METRES;
+            }
+        }
+    }
+    fclose(config);
+
+    for (k = 0; k < graph_nodes; k++)
+    {
+        float *through = &graph_distance[k * graph_nodes];
+        for (i = 0; i < graph_nodes; i++)
+        {
+            float *row = &graph_distance[i * graph_nodes];
+            float to_k = row[k];
+            if (isinf(to_k))
+                continue;
+            for (j = 0; j < graph_nodes; j++)
+            {
+                if (to_k + through[j] < row[j])
+                    row[j] = to_k + through[j];
+            }
+        }
+    }
+
+    nearest_facilities = (FacilityDistance *)malloc(sizeof(FacilityDistance) * graph_nodes * facility_count);
+    for (i = 0; i < graph_nodes; i++)
+    {
+        FacilityDistance *order = &nearest_facilities[i * facility_count];
+        for (j = 0; j < facility_count; j++)
+        {
+            order[j].facility = j;
+            order[j].metres = graph_distance[i * graph_nodes + j];
+        }
+        qsort(order, facility_count, sizeof(FacilityDistance), compare_facility_distance);
+    }
+}
+
+// True if kind appears in a comma-separated list of kinds
+int kind_in_list(const char *kind, const char *kinds)
+{
+    size_t length = strlen(kind);
+    while (*kinds != '\0')
+    {
+        while (*kinds == ',' || *kinds == ' ')
+            kinds++;
+        size_t token = strcspn(kinds, ",");
+        while (token > 0 && kinds[token - 1] == ' ')
+            token--;
+        if (token == length && strncasecmp(kinds, kind, length) == 0)
+            return 1;
+        kinds += strcspn(kinds, ",");
+    }
+    return 0;
+}
+
+// Nearest facility of the given kinds with places in a run of slots; NULL if none is reachable
+FacilityDistance *nearest_facility(int node, const char *kinds, Date d, int slot, int count)
+{
+    int i;
+    FacilityDistance *order = &nearest_facilities[node * facility_count];
+    for (i = 0; i < facility_count && !isinf(order[i].metres); i++)
+    {
+        Facility *facility = &facilities[order[i].facility];
+        if (kind_in_list(facility->kind, kinds) && slots_free(order[i].facility, d, slot, count))
+            return &order[i];
+    }
+    return NULL;
+}
+
+// Name of a facility ID, tolerating IDs from a larger earlier configuration
+const char *facility_name(int facility_id)
+{
+    return facility_id >= 1 && facility_id <= facility_count ? facilities[facility_id - 1].name : "Unknown";
+}
+
+// Find nearby facilities
+void find_nearby_facilities(int facility_id)
+{
+    int i, shown = 0;
+    if (facility_id < 1 || facility_id > facility_count)
+    {
+        printf("Invalid facility ID!\n");
+        return;
+    }
+    FacilityDistance *order = &nearest_facilities[(facility_id - 1) * facility_count];
+    printf("Facilities near %s:\n", facilities[facility_id - 1].name);
+    for (i = 0; i < facility_count && shown < NEARBY_FACILITIES && !isinf(order[i].metres); i++)
+    {
+        Facility *facility = &facilities[order[i].facility];
+        if (order[i].facility == facility_id - 1)
+            continue;
+        shown++;
+        printf("- %s, %.0f m ($%.2f)\n", facility->name, order[i].metres, facility->booking_fee);
+    }
+}
+
+// ======================== SNAPSHOT OPERATIONS ========================
+
+// Count one booking into the status gauges
+void count_booking_status(BookingNode *booking, void *ctx)
+{
+    if (booking->status == 0)
+        metric_add(&metrics.bookings_upcoming, 1);
+    else if (booking->status == 1)
+        metric_add(&metrics.bookings_active, 1);
+    else if (booking->status == 2)
+        metric_add(&metrics.bookings_completed, 1);
+}
+
+// Derive every metric from current state; used after loading, never per view
+void recount_metrics()
+{
+    int i;
+    memset(&metrics, 0, sizeof(metrics));
+    for (i = 0; i < MAX_ROOMS; i++)
+    {
+        if (rooms.status[i] == 1)
+            metric_add(&metrics.rooms_occupied, 1);
+        else if (rooms.status[i] == 2)
+            metric_add(&metrics.rooms_in_maintenance, 1);
+    }
+    for (i = 1; i <= MAX_PARKING; i++)
+    {
+        if (parking_by_no[i] != NULL && parking_by_no[i]->status == 1)
+            metric_add(&metrics.parking_occupied, 1);
+    }
+    scan_bookings(booking_tree, make_date(1, 1, CALENDAR_START_YEAR), make_date(31, 12, DATE_MAX_YEAR),
+                  count_booking_status, NULL);
+    for (i = 0; i < services.count; i++)
+    {
+        if (strcmp(((RoomService *)table_at(&services, i))->status, "Completed") != 0)
+            metric_add(&metrics.services_pending, 1);
+    }
+    for (i = 0; i < maintenance.count; i++)
+    {
+        if (strcmp(((MaintenanceRequest *)table_at(&maintenance, i))->status, "Resolved") != 0)
+            metric_add(&metrics.maintenance_open, 1);
+    }
+    for (i = 0; i < feedbacks.count; i++)
+    {
+        metric_add(&metrics.feedback_count, 1);
+        metric_add(&metrics.rating_sum, ((Feedback *)table_at(&feedbacks, i))->rating);
+    }
+}
+
+// Pad to the next aligned offset and start a section
+void begin_snapshot_section(FILE *file, SnapshotHeader *header, int section, long long elem_size)
+{
+    static const char zeros[SNAPSHOT_ALIGN] = {0};
+    long pos = ftell(file);
+    fwrite(zeros, 1, (SNAPSHOT_ALIGN - pos % SNAPSHOT_ALIGN) % SNAPSHOT_ALIGN, file);
+    header->sections[section].offset = ftell(file);
+    header->sections[section].count = 0;
+    header->sections[section].elem_size = elem_size;
+}
+
+// Append records to a section
+void write_snapshot_records(FILE *file, SnapshotHeader *header, int section,
+                            const void *records, long long count)
+{
+    fwrite(records, header->sections[section].elem_size, count, file);
+    header->sections[section].count += count;
+}
+
+// Write every record of a table as one section
+void write_snapshot_table(FILE *file, SnapshotHeader *header, int section, Table *table)
+{
+    int i;
+    begin_snapshot_section(file, header, section, table->elem_size);
+    for (i = 0; i < table->chunk_count; i++)
+    {
+        int in_chunk = table->count - i * TABLE_CHUNK;
+        write_snapshot_records(file, header, section, table->chunks[i],
+                               in_chunk < TABLE_CHUNK ? in_chunk : TABLE_CHUNK);
+    }
+}
+
+// Write bookings in check-in order
+void write_snapshot_bookings(FILE *file, SnapshotHeader *header, BookingNode *node)
+{
+    if (node == NULL)
+        return;
+    write_snapshot_bookings(file, header, node->left);
+    write_snapshot_records(file, header, SNAP_BOOKINGS, node, 1);
+    write_snapshot_bookings(file, header, node->right);
+}
+
+// Save all state to a snapshot file; written to a temp file and renamed into place
+int save_snapshot(const char *path)
+{
+    int i;
+    char tmp_path[256];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *file = fopen(tmp_path, "wb");
+    if (file == NULL)
+        return 0;
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "HOTELSNP", 8);
+    header.version = SNAPSHOT_VERSION;
+    header.user_count = user_count;
+    header.booking_id_seq = booking_id_seq;
+    header.wal_lsn = wal_last_lsn;
+    header.total_revenue = total_revenue;
+    fwrite(&header, sizeof(header), 1, file);
+
+    begin_snapshot_section(file, &header, SNAP_ROOMS, sizeof(RoomColumns));
+    write_snapshot_records(file, &header, SNAP_ROOMS, &rooms, 1);
+    begin_snapshot_section(file, &header, SNAP_CALENDAR, sizeof(room_calendar[0]));
+    write_snapshot_records(file, &header, SNAP_CALENDAR, room_calendar, CALENDAR_DAYS);
+    begin_snapshot_section(file, &header, SNAP_USERS, sizeof(User));
+    write_snapshot_records(file, &header, SNAP_USERS, users, user_count);
+
+    begin_snapshot_section(file, &header, SNAP_GUESTS, sizeof(Guest));
+    Guest *guest;
+    for (guest = guest_list; guest != NULL; guest = guest->next)
+        write_snapshot_records(file, &header, SNAP_GUESTS, guest, 1);
+    begin_snapshot_section(file, &header, SNAP_BOOKINGS, sizeof(BookingNode));
+    write_snapshot_bookings(file, &header, booking_tree);
+
+    begin_snapshot_section(file, &header, SNAP_PARKING, sizeof(ParkingSlot));
+    for (i = 1; i <= MAX_PARKING; i++)
+        write_snapshot_records(file, &header, SNAP_PARKING, parking_by_no[i], 1);
+    begin_snapshot_section(file, &header, SNAP_WAITLIST, sizeof(WaitlistEntry));
+    unsigned int pos;
+    for (pos = waitlist_head; pos != waitlist_tail; pos++)
+        write_snapshot_records(file, &header, SNAP_WAITLIST, &parking_waitlist[pos % MAX_WAITLIST], 1);
+
+    write_snapshot_table(file, &header, SNAP_SERVICES, &services);
+    write_snapshot_table(file, &header, SNAP_MAINTENANCE, &maintenance);
+    write_snapshot_table(file, &header, SNAP_FEEDBACKS, &feedbacks);
+    write_snapshot_table(file, &header, SNAP_INVENTORY, &inventory);
+    write_snapshot_table(file, &header, SNAP_EVENTS, &events);
+    write_snapshot_table(file, &header, SNAP_SCHEDULES, &schedules);
+    write_snapshot_table(file, &header, SNAP_BILLS, &bills);
+    pthread_mutex_lock(&logs_lock);
+    write_snapshot_table(file, &header, SNAP_LOGS, &logs);
+    pthread_mutex_unlock(&logs_lock);
+    begin_snapshot_section(file, &header, SNAP_ROLLUPS, sizeof(RollupPage));
+    for (i = 0; i < CALENDAR_MONTHS; i++)
+    {
+        if (rollup_pages[i] != NULL)
+            write_snapshot_records(file, &header, SNAP_ROLLUPS, rollup_pages[i], 1);
+    }
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    int ok = fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || rename(tmp_path, path) != 0)
+    {
+        remove(tmp_path);
+        return 0;
+    }
+    return 1;
+}
+
+// Records of a validated section inside the mapped snapshot
+void *snapshot_records(SnapshotHeader *header, int section)
+{
+    return (char *)header + header->sections[section].offset;
+}
+
+// Check record fields that loading uses as array indexes
+// Whether a fixed-size string read from a file ends inside its field
+int field_terminated(const char *field, size_t size)
+{
+    return memchr(field, '\0', size) != NULL;
+}
+
+int snapshot_records_valid(SnapshotHeader *header)
+{
+    long long i;
+    RoomColumns *saved_rooms = (RoomColumns *)snapshot_records(header, SNAP_ROOMS);
+    for (i = 0; i < MAX_ROOMS; i++)
+    {
+        if (saved_rooms->type[i] < 1 || saved_rooms->type[i] >= ROLLUP_TYPES ||
+            saved_rooms->floor[i] < 1 || saved_rooms->floor[i] > FLOORS)
+            return 0;
+    }
+    if (saved_rooms->feature_count < 0 || saved_rooms->feature_count > MAX_FEATURES)
+        return 0;
+    // IDs and passwords are hashed and compared with strcmp
+    User *saved_users = (User *)snapshot_records(header, SNAP_USERS);
+    for (i = 0; i < header->sections[SNAP_USERS].count; i++)
+    {
+        if (!field_terminated(saved_users[i].id, MAX_ID) || !field_terminated(saved_users[i].pass, MAX_PASS))
+            return 0;
+    }
+    Guest *guests = (Guest *)snapshot_records(header, SNAP_GUESTS);
+    for (i = 0; i < header->sections[SNAP_GUESTS].count; i++)
+    {
+        if (!field_terminated(guests[i].id, MAX_ID))
+            return 0;
+    }
+    BookingNode *bookings = (BookingNode *)snapshot_records(header, SNAP_BOOKINGS);
+    for (i = 0; i < header->sections[SNAP_BOOKINGS].count; i++)
+    {
+        if ((bookings[i].room_no != -1 && (bookings[i].room_no < 1 || bookings[i].room_no > MAX_ROOMS)) ||
+            !is_valid_date(bookings[i].check_in) || !is_valid_date(bookings[i].check_out) ||
+            bookings[i].status < 0 || bookings[i].status > 3 ||
+            !field_terminated(bookings[i].booking_id, sizeof(bookings[i].booking_id)) ||
+            !field_terminated(bookings[i].guest_id, MAX_ID))
+            return 0;
+    }
+    ParkingSlot *slots = (ParkingSlot *)snapshot_records(header, SNAP_PARKING);
+    for (i = 0; i < header->sections[SNAP_PARKING].count; i++)
+    {
+        if (slots[i].slot_no < 1 || slots[i].slot_no > MAX_PARKING || !field_terminated(slots[i].guest_id, MAX_ID))
+            return 0;
+    }
+    WaitlistEntry *waiting = (WaitlistEntry *)snapshot_records(header, SNAP_WAITLIST);
+    for (i = 0; i < header->sections[SNAP_WAITLIST].count; i++)
+    {
+        if (!field_terminated(waiting[i].guest_id, MAX_ID))
+            return 0;
+    }
+    Event *saved_events = (Event *)snapshot_records(header, SNAP_EVENTS);
+    for (i = 0; i < header->sections[SNAP_EVENTS].count; i++)
+    {
+        if (saved_events[i].status < 0 || saved_events[i].status > 2)
+            return 0;
+    }
+    return header->sections[SNAP_WAITLIST].count <= MAX_WAITLIST;
+}
+
+// Map a snapshot and use its records in place; returns 0 if absent, -1 if unreadable or incompatible
+int load_snapshot(const char *path)
+{
+    long long i;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return errno == ENOENT ? 0 : -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SnapshotHeader))
+    {
+        close(fd);
+        return -1;
+    }
+    // Private mapping: records are updated in memory, never written back to the file
+    void *map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+    SnapshotHeader *header = (SnapshotHeader *)map;
+    long long sizes[SNAPSHOT_SECTIONS] = {
+        sizeof(RoomColumns), sizeof(room_calendar[0]), sizeof(User),
+        sizeof(Guest), sizeof(BookingNode), sizeof(ParkingSlot), sizeof(WaitlistEntry),
+        sizeof(RoomService), sizeof(MaintenanceRequest), sizeof(Feedback), sizeof(InventoryItem),
+        sizeof(Event), sizeof(StaffSchedule), sizeof(Bill), sizeof(SystemLog), sizeof(RollupPage)};
+    long long limits[SNAPSHOT_SECTIONS] = {
+        1, CALENDAR_DAYS, MAX_STAFF + 1, -1, -1, MAX_PARKING, MAX_WAITLIST,
+        -1, -1, -1, -1, -1, -1, -1, -1, CALENDAR_MONTHS};
+    int valid = memcmp(header->magic, "HOTELSNP", 8) == 0 && header->version == SNAPSHOT_VERSION;
+    for (i = 0; valid && i < SNAPSHOT_SECTIONS; i++)
+    {
+        SnapshotSection *section = &header->sections[i];
+        valid = section->elem_size == sizes[i] && section->count >= 0 &&
+                (limits[i] < 0 || section->count <= limits[i]) &&
+                section->offset % SNAPSHOT_ALIGN == 0 &&
+                section->offset + section->count * section->elem_size <= (long long)st.st_size;
+    }
+    valid = valid && snapshot_records_valid(header);
+    if (!valid)
+    {
+        munmap(map, st.st_size);
+        return -1;
+    }
+    snapshot_map = map;
+    snapshot_map_size = st.st_size;
+
+    memcpy(&rooms, snapshot_records(header, SNAP_ROOMS), sizeof(rooms));
+    memcpy(room_calendar, snapshot_records(header, SNAP_CALENDAR), sizeof(room_calendar));
+    user_count = header->sections[SNAP_USERS].count;
+    memcpy(users, snapshot_records(header, SNAP_USERS), user_count * sizeof(User));
+    booking_id_seq = header->booking_id_seq;
+    wal_last_lsn = wal_durable_lsn = header->wal_lsn;
+    total_revenue = header->total_revenue;
+
+    // Guests are used in place; only links and the ID index are rebuilt
+    Guest *guests = (Guest *)snapshot_records(header, SNAP_GUESTS);
+    guest_count = header->sections[SNAP_GUESTS].count;
+    string_index_reserve(&guest_index, guest_count);
+    for (i = 0; i < guest_count; i++)
+    {
+        guests[i].bookings = NULL;
+        guests[i].next = (i + 1 < guest_count) ? &guests[i + 1] : NULL;
+        string_index_insert(&guest_index, guests[i].id, &guests[i]);
+    }
+    guest_list = guest_count > 0 ? &guests[0] : NULL;
+
+    // Bookings arrive sorted by check-in, so the tree is built balanced in O(n)
+    BookingNode *bookings = (BookingNode *)snapshot_records(header, SNAP_BOOKINGS);
+    booking_count = header->sections[SNAP_BOOKINGS].count;
+    booking_tree = build_booking_tree(bookings, 0, booking_count - 1);
+    string_index_reserve(&booking_index, booking_count);
+    for (i = booking_count - 1; i >= 0; i--)
+    {
+        BookingNode *booking = &bookings[i];
+        string_index_insert(&booking_index, booking->booking_id, booking);
+        Guest *guest = find_guest(booking->guest_id);
+        booking->next_for_guest = NULL;
+        if (guest != NULL)
+        {
+            booking->next_for_guest = guest->bookings;
+            guest->bookings = booking;
+        }
+    }
+    for (i = 0; i < booking_count; i++)
+    {
+        if (bookings[i].status == 0)
+            push_booking_event(calendar_day(bookings[i].check_in), 1, &bookings[i]);
+        else if (bookings[i].status == 1)
+        {
+            push_booking_event(calendar_day(bookings[i].check_out), 0, &bookings[i]);
+            if (bookings[i].room_no != -1)
+                room_occupant[bookings[i].room_no - 1] = &bookings[i];
+        }
+        // Facility slot calendars are rebuilt from their bookings rather than stored
+        if (bookings[i].facility_id >= 1 && bookings[i].facility_id <= facility_count &&
+            is_valid_date(bookings[i].check_in) && valid_slot_range(bookings[i].slot, bookings[i].slots))
+            reserve_slots(bookings[i].facility_id - 1, bookings[i].check_in, bookings[i].slot, bookings[i].slots);
+    }
+
+    ParkingSlot *slots = (ParkingSlot *)snapshot_records(header, SNAP_PARKING);
+    for (i = 0; i < header->sections[SNAP_PARKING].count; i++)
+    {
+        if (slots[i].status == 1)
+            occupy_parking_slot(slots[i].slot_no, slots[i].guest_id, slots[i].vehicle);
+    }
+    waitlist_head = 0;
+    waitlist_tail = header->sections[SNAP_WAITLIST].count;
+    memcpy(parking_waitlist, snapshot_records(header, SNAP_WAITLIST),
+           waitlist_tail * sizeof(WaitlistEntry));
+
+    table_adopt(&services, snapshot_records(header, SNAP_SERVICES), header->sections[SNAP_SERVICES].count);
+    table_adopt(&maintenance, snapshot_records(header, SNAP_MAINTENANCE), header->sections[SNAP_MAINTENANCE].count);
+    table_adopt(&feedbacks, snapshot_records(header, SNAP_FEEDBACKS), header->sections[SNAP_FEEDBACKS].count);
+    table_adopt(&inventory, snapshot_records(header, SNAP_INVENTORY), header->sections[SNAP_INVENTORY].count);
+    table_adopt(&events, snapshot_records(header, SNAP_EVENTS), header->sections[SNAP_EVENTS].count);
+    table_adopt(&schedules, snapshot_records(header, SNAP_SCHEDULES), header->sections[SNAP_SCHEDULES].count);
+    table_adopt(&bills, snapshot_records(header, SNAP_BILLS), header->sections[SNAP_BILLS].count);
+    pthread_mutex_lock(&logs_lock);
+    table_adopt(&logs, snapshot_records(header, SNAP_LOGS), header->sections[SNAP_LOGS].count);
+    pthread_mutex_unlock(&logs_lock);
+    RollupPage *pages = (RollupPage *)snapshot_records(header, SNAP_ROLLUPS);
+    for (i = 0; i < header->sections[SNAP_ROLLUPS].count; i++)
+    {
+        int month = pages[i].month;
+        if (month < 0 || month >= CALENDAR_MONTHS)
+            continue;
+        if (rollup_pages[month] == NULL)
+            rollup_pages[month] = (RollupPage *)malloc(sizeof(RollupPage));
+        *rollup_pages[month] = pages[i];
+    }
+    recount_metrics();
+    return 1;
+}
+
+// Release guests, bookings and parking slots in bulk and clear their indexes
+void release_records()
+{
+    long long i;
+    pool_release_all(&guest_pool);
+    pool_release_all(&booking_pool);
+    pool_release_all(&parking_pool);
+    guest_list = NULL;
+    booking_tree = NULL;
+    memset(room_occupant, 0, sizeof(room_occupant));
+    parking_slots = NULL;
+    free(guest_index.slots);
+    free(booking_index.slots);
+    free(parking_index.slots);
+    guest_index = booking_index = parking_index = (StringIndex){NULL, 0, 0};
+    booking_event_count = 0;
+    memset(parking_by_no, 0, sizeof(parking_by_no));
+    memset(parking_free, 0, sizeof(parking_free));
+    waitlist_head = waitlist_tail = 0;
+    guest_count = booking_count = 0;
+    for (i = 0; i < (long long)facility_count * SLOT_PAGES; i++)
+    {
+        free(slot_pages[i]);
+        slot_pages[i] = NULL;
+    }
+    recount_metrics();
+    if (snapshot_map != NULL)
+        munmap(snapshot_map, snapshot_map_size);
+    snapshot_map = NULL;
+}
+
+// ======================== MUTATION OPERATIONS ========================
+
+char *status_messages[ST_STATUSES] = {
+    "OK", "Guest ID exists!", "Guest not found!", "Invalid dates!",
+    "Invalid date!", "Invalid or unavailable room!", "Room changed since availability was checked!", "Invalid room number!", "Room not occupied!",
+    "Invalid choice!", "Guest already has a parking slot!", "Guest already on the parking waitlist!",
+    "No parking available and waitlist is full!", "No vehicles in waitlist.",
+    "Facility fully booked at that time!", "Invalid facility ID!", "Invalid time slot!", "Service ID not found!", "Order already completed!",
+    "Invalid issue type!", "Invalid priority!", "Request ID not found!", "Request already resolved!", "Invalid rating!",
+    "Item not found!", "Event not found!", "Invalid status!", "Staff ID not found!",
+    "Schedule not found!", "Invalid booking ID!", "Bill not found!", "Bill already paid!",
+    "Write-ahead log failed; change is not durable!"};
+
+char *service_items[] = {"Breakfast Set", "Lunch Set", "Dinner Set", "Snack Pack", "Beverage"};
+float service_prices[] = {15.0, 20.0, 25.0, 10.0, 5.0};
+
+// Print the failure message; returns 1 if the operation failed
+int op_failed(OpStatus status)
+{
+    if (status == ST_OK)
+        return 0;
+    printf("%s\n", status_messages[status]);
+    return 1;
+}
+
+OpStatus apply_add_guest(GuestOp *op, OpResult *result)
+{
+    if (find_guest(op->id) != NULL)
+        return ST_GUEST_EXISTS;
+    Guest new_guest;
+    strcpy(new_guest.id, op->id);
+    strcpy(new_guest.name, op->name);
+    strcpy(new_guest.contact, op->contact);
+    strcpy(new_guest.email, op->email);
+    strcpy(new_guest.preferences, op->preferences);
+    add_guest_to_list(&guest_list, new_guest);
+    return ST_OK;
+}
+
+// Check a stay's dates and room number
+OpStatus check_room_stay(BookingOp *op)
+{
+    if (!is_valid_date(op->check_in) || !is_valid_date(op->check_out) ||
+        date_diff(op->check_in, op->check_out) <= 0)
+        return ST_INVALID_DATES;
+    if (op->room_no < 1 || op->room_no > MAX_ROOMS)
+        return ST_ROOM_UNAVAILABLE;
+    return ST_OK;
+}
+
+// Validate a stay and take its nights; needs no subsystem lock
+OpStatus reserve_room_booking(BookingOp *op, unsigned int room_version)
+{
+    OpStatus status = check_room_stay(op);
+    if (status != ST_OK)
+        return status;
+    return commit_room_nights(op->room_no, op->check_in, op->check_out, room_version);
+}
+
+// ROOM_RESERVED: the nights are already held and are given back if the booking fails
+OpStatus apply_book_room(BookingOp *op, unsigned int room_version, OpResult *result)
+{
+    OpStatus stay = check_room_stay(op);
+    if (stay != ST_OK)
+        return stay;
+    Guest *guest = find_guest(op->guest_id);
+    if (guest == NULL)
+    {
+        if (room_version == ROOM_RESERVED)
+            cancel_room_nights(op->room_no, op->check_in, op->check_out);
+        return ST_GUEST_NOT_FOUND;
+    }
+    if (room_version != ROOM_RESERVED)
+    {
+        OpStatus status = reserve_room_booking(op, room_version);
+        if (status != ST_OK)
+            return status;
+    }
+    float base_price = rooms.price[op->room_no - 1] * date_diff(op->check_in, op->check_out);
+    float discount = (guest->loyalty_points >= DISCOUNT_THRESHOLD) ? base_price * 0.1 : 0;
+    float total = base_price - discount;
+    if (discount > 0)
+        guest->loyalty_points -= DISCOUNT_THRESHOLD;
+    int points_earned = (int)(total / 100) * LOYALTY_POINTS_RATE;
+    guest->loyalty_points += points_earned;
+    BookingNode *booking = new_booking_node(op->guest_id, op->room_no, -1, -1,
+                                            op->check_in, op->check_out, total);
+    booking_tree = insert_booking(booking_tree, booking);
+    schedule_booking(booking);
+    rollup_booking(booking);
+    result->booking = booking;
+    result->amount = discount;
+    result->points = points_earned;
+    return ST_OK;
+}
+
+OpStatus apply_assign_parking(ParkingOp *op, OpResult *result)
+{
+    ParkingSlot *slot = find_guest_parking(op->guest_id);
+    if (slot != NULL)
+    {
+        result->id = slot->slot_no;
+        return ST_PARKING_HELD;
+    }
+    // A queued guest is placed by the waitlist, in turn
+    if (in_waitlist(op->guest_id))
+        return ST_ALREADY_WAITLISTED;
+    slot = allocate_parking_slot(op->guest_id, op->vehicle);
+    if (slot != NULL)
+    {
+        link_parking_to_booking(op->guest_id, slot->slot_no);
+        result->id = slot->slot_no;
+        return ST_OK;
+    }
+    if (!add_to_waitlist(op->vehicle, op->guest_id))
+        return ST_WAITLIST_FULL;
+    result->id = -1;
+    return ST_OK;
+}
+
+// Place waitlisted vehicles, oldest first, into free slots in one pass. Entries whose guest
+// already holds a slot are dropped; placed entries are packed from the old head for callers.
+OpStatus apply_process_waitlist(OpResult *result)
+{
+    int placed = 0;
+    unsigned int first = waitlist_head;
+    if (waitlist_head == waitlist_tail)
+        return ST_WAITLIST_EMPTY;
+    int free_slots[MAX_WAITLIST];
+    int assigned = collect_free_parking(free_slots, waitlist_tail - waitlist_head);
+    while (placed < assigned && waitlist_head != waitlist_tail)
+    {
+        WaitlistEntry *waiting = remove_from_waitlist();
+        if (find_guest_parking(waiting->guest_id) != NULL)
+            continue;
+        occupy_parking_slot(free_slots[placed], waiting->guest_id, waiting->vehicle);
+        link_parking_to_booking(waiting->guest_id, free_slots[placed]);
+        parking_waitlist[(first + placed++) % MAX_WAITLIST] = *waiting;
+    }
+    result->count = placed;
+    return ST_OK;
+}
+
+OpStatus apply_book_facility(BookingOp *op, OpResult *result)
+{
+    if (op->facility_id < 1 || op->facility_id > facility_count)
+        return ST_INVALID_FACILITY;
+    Guest *guest = find_guest(op->guest_id);
+    if (guest == NULL)
+        return ST_GUEST_NOT_FOUND;
+    if (!is_valid_date(op->check_in))
+        return ST_INVALID_DATE;
+    if (!valid_slot_range(op->slot, op->slots))
+        return ST_INVALID_SLOT;
+    if (!slots_free(op->facility_id - 1, op->check_in, op->slot, op->slots))
+        return ST_FACILITY_UNAVAILABLE;
+    float fee = facilities[op->facility_id - 1].booking_fee;
+    if (guest->loyalty_points >= DISCOUNT_THRESHOLD && fee > 0)
+    {
+        result->amount = fee * 0.5;
+        fee *= 0.5;
+        guest->loyalty_points -= DISCOUNT_THRESHOLD;
+    }
+    reserve_slots(op->facility_id - 1, op->check_in, op->slot, op->slots);
+    BookingNode *booking = new_booking_node(op->guest_id, -1, -1, op->facility_id,
+                                            op->check_in, op->check_in, fee);
+    booking->slot = op->slot;
+    booking->slots = op->slots;
+    booking_tree = insert_booking(booking_tree, booking);
+    schedule_booking(booking);
+    int points_earned = strcasecmp(facilities[op->facility_id - 1].kind, NO_POINTS_KIND) == 0 ? 0 : 5;
+    guest->loyalty_points += points_earned;
+    result->booking = booking;
+    result->points = points_earned;
+    return ST_OK;
+}
+
+OpStatus apply_order_service(ServiceOrderOp *op, OpResult *result)
+{
+    if (op->room_no < 1 || op->room_no > MAX_ROOMS)
+        return ST_INVALID_ROOM;
+    BookingNode *booking = room_occupant[op->room_no - 1];
+    if (booking == NULL)
+        return ST_ROOM_NOT_OCCUPIED;
+    if (op->item < 1 || op->item > 5)
+        return ST_INVALID_CHOICE;
+    RoomService *service = (RoomService *)table_push(&services);
+    service->service_id = services.count;
+    service->room_no = op->room_no;
+    strcpy(service->booking_id, booking->booking_id);
+    strcpy(service->items, service_items[op->item - 1]);
+    strcpy(service->time, op->time);
+    strcpy(service->status, "Pending");
+    service->charge = service_prices[op->item - 1];
+    metric_add(&metrics.services_pending, 1);
+    result->id = service->service_id;
+    return ST_OK;
+}
+
+OpStatus apply_update_service(StatusOp *op, OpResult *result)
+{
+    RoomService *service = (RoomService *)table_find(&services, op->id);
+    if (service == NULL)
+        return ST_SERVICE_NOT_FOUND;
+    // A completed order has already been charged; reopening it would charge it twice
+    if (strcmp(service->status, "Completed") == 0)
+        return ST_SERVICE_COMPLETED;
+    if (op->choice == 1)
+    {
+        strcpy(service->status, "In Progress");
+    }
+    else if (op->choice == 2)
+    {
+        strcpy(service->status, "Completed");
+        metric_add(&metrics.services_pending, -1);
+        BookingNode *booking = find_booking(service->booking_id);
+        if (booking != NULL)
+        {
+            booking->service_charges += service->charge;
+            Guest *guest = find_guest(booking->guest_id);
+            if (guest != NULL)
+                guest->loyalty_points += 1;
+        }
+    }
+    else
+    {
+        return ST_INVALID_CHOICE;
+    }
+    result->id = op->id;
+    return ST_OK;
+}
+
+OpStatus apply_report_maintenance(MaintenanceOp *op, OpResult *result)
+{
+    if (op->room_no < 1 || op->room_no > MAX_ROOMS)
+        return ST_INVALID_ROOM;
+    if (op->issue_type < 1 || op->issue_type > 5)
+        return ST_INVALID_ISSUE;
+    if (op->priority < 1 || op->priority > 3)
+        return ST_INVALID_PRIORITY;
+    char *issues[] = {"Electrical", "Plumbing", "HVAC", "Furniture", "Other"};
+    char *priorities[] = {"Low", "Medium", "High"};
+    MaintenanceRequest *request = (MaintenanceRequest *)table_push(&maintenance);
+    request->request_id = maintenance.count;
+    request->room_no = op->room_no;
+    strcpy(request->issue, issues[op->issue_type - 1]);
+    strcat(request->issue, ": ");
+    strcat(request->issue, op->description);
+    strcpy(request->priority, priorities[op->priority - 1]);
+    strcpy(request->status, "Open");
+    request->report_date = op->date;
+    set_room_status(op->room_no, 2);
+    metric_add(&metrics.maintenance_open, 1);
+    result->id = request->request_id;
+    return ST_OK;
+}
+
+OpStatus apply_update_maintenance(StatusOp *op, OpResult *result)
+{
+    MaintenanceRequest *request = (MaintenanceRequest *)table_find(&maintenance, op->id);
+    if (request == NULL)
+        return ST_REQUEST_NOT_FOUND;
+    if (strcmp(request->status, "Resolved") == 0)
+        return ST_REQUEST_RESOLVED;
+    if (op->choice == 1)
+    {
+        strcpy(request->status, "In Progress");
+    }
+    else if (op->choice == 2)
+    {
+        strcpy(request->status, "Resolved");
+        set_room_status(request->room_no, 0);
+        metric_add(&metrics.maintenance_open, -1);
+    }
+    else
+    {
+        return ST_INVALID_CHOICE;
+    }
+    result->id = op->id;
+    return ST_OK;
+}
+
+OpStatus apply_submit_feedback(FeedbackOp *op, OpResult *result)
+{
+    if (find_guest(op->guest_id) == NULL)
+        return ST_GUEST_NOT_FOUND;
+    if (op->rating < 1 || op->rating > 5)
+        return ST_INVALID_RATING;
+    Feedback *feedback = (Feedback *)table_push(&feedbacks);
+    feedback->feedback_id = feedbacks.count;
+    strcpy(feedback->guest_id, op->guest_id);
+    strcpy(feedback->comment, op->comment);
+    feedback->rating = op->rating;
+    feedback->date = op->date;
+    metric_add(&metrics.feedback_count, 1);
+    metric_add(&metrics.rating_sum, op->rating);
+    result->id = feedback->feedback_id;
+    return ST_OK;
+}
+
+OpStatus apply_add_item(ItemOp *op, OpResult *result)
+{
+    InventoryItem *item = (InventoryItem *)table_push(&inventory);
+    item->item_id = inventory.count;
+    strcpy(item->name, op->name);
+    strcpy(item->category, op->category);
+    item->quantity = op->quantity;
+    item->unit_price = op->unit_price;
+    item->reorder_level = op->reorder_level;
+    result->id = item->item_id;
+    return ST_OK;
+}
+
+OpStatus apply_update_quantity(QuantityOp *op, OpResult *result)
+{
+    InventoryItem *item = (InventoryItem *)table_find(&inventory, op->id);
+    if (item == NULL)
+        return ST_ITEM_NOT_FOUND;
+    item->quantity = op->quantity;
+    result->id = op->id;
+    return ST_OK;
+}
+
+OpStatus apply_add_event(EventOp *op, OpResult *result)
+{
+    if (op->facility_id < 1 || op->facility_id > facility_count)
+        return ST_INVALID_FACILITY;
+    Event *event = (Event *)table_push(&events);
+    strcpy(event->name, op->name);
+    event->date = op->date;
+    strcpy(event->time, op->time);
+    event->facility_id = op->facility_id;
+    strcpy(event->organizer, op->organizer);
+    event->capacity = op->capacity;
+    event->cost = op->cost;
+    event->event_id = events.count;
+    event->status = 0;
+    result->id = event->event_id;
+    return ST_OK;
+}
+
+OpStatus apply_update_event(StatusOp *op, OpResult *result)
+{
+    Event *event = (Event *)table_find(&events, op->id);
+    if (event == NULL)
+        return ST_EVENT_NOT_FOUND;
+    if (op->choice != 1 && op->choice != 2)
+        return ST_INVALID_STATUS;
+    event->status = op->choice;
+    result->id = op->id;
+    return ST_OK;
+}
+
+OpStatus apply_add_schedule(ScheduleOp *op, OpResult *result)
+{
+    int i;
+    int staff_found = 0;
+    for (i = 0; i < user_count; i++)
+    {
+        if (strcmp(users[i].id, op->staff_id) == 0)
+        {
+            staff_found = 1;
+            break;
+        }
+    }
+    if (!staff_found)
+        return ST_STAFF_NOT_FOUND;
+    StaffSchedule *schedule = (StaffSchedule *)table_push(&schedules);
+    strcpy(schedule->staff_id, op->staff_id);
+    schedule->date = op->date;
+    strcpy(schedule->shift, op->shift);
+    strcpy(schedule->task, op->task);
+    schedule->schedule_id = schedules.count;
+    result->id = schedule->schedule_id;
+    return ST_OK;
+}
+
+OpStatus apply_update_schedule(ScheduleOp *op, OpResult *result)
+{
+    StaffSchedule *schedule = (StaffSchedule *)table_find(&schedules, op->id);
+    if (schedule == NULL)
+        return ST_SCHEDULE_NOT_FOUND;
+    strcpy(schedule->shift, op->shift);
+    strcpy(schedule->task, op->task);
+    result->id = op->id;
+    return ST_OK;
+}
+
+OpStatus apply_generate_bill(BillOp *op, OpResult *result)
+{
+    if (find_guest(op->guest_id) == NULL)
+        return ST_GUEST_NOT_FOUND;
+    BookingNode *booking = find_booking(op->booking_id);
+    if (booking == NULL || strcmp(booking->guest_id, op->guest_id) != 0)
+        return ST_INVALID_BOOKING;
+    float room_charges = 0, service_charges = 0, facility_charges = 0;
+    if (booking->room_no != -1)
+    {
+        room_charges = booking->total;
+    }
+    if (booking->facility_id != -1)
+    {
+        facility_charges = booking->total;
+    }
+    service_charges = booking->service_charges;
+    float taxes = (room_charges + service_charges + facility_charges) * 0.1; // 10% tax
+    Bill *bill = (Bill *)table_push(&bills);
+    bill->bill_id = bills.count;
+    strcpy(bill->guest_id, op->guest_id);
+    strcpy(bill->booking_id, op->booking_id);
+    bill->room_charges = room_charges;
+    bill->service_charges = service_charges;
+    bill->facility_charges = facility_charges;
+    bill->taxes = taxes;
+    bill->total = room_charges + service_charges + facility_charges + taxes;
+    bill->status = 0;
+    bill->issue_date = op->date;
+    result->id = bill->bill_id;
+    return ST_OK;
+}
+
+OpStatus apply_process_payment(PaymentOp *op, OpResult *result)
+{
+    Bill *bill = (Bill *)table_find(&bills, op->id);
+    if (bill == NULL)
+        return ST_BILL_NOT_FOUND;
+    if (bill->status == 1)
+        return ST_BILL_PAID;
+    if (op->method != 1 && op->method != 2)
+        return ST_INVALID_CHOICE;
+    if (!is_valid_date(op->date))
+        return ST_INVALID_DATE;
+    bill->status = 1;
+    total_revenue += bill->total;
+    rollup_payment(bill, op->date);
+    Guest *guest = find_guest(bill->guest_id);
+    if (guest != NULL)
+    {
+        result->points = (int)(bill->total / 100) * LOYALTY_POINTS_RATE;
+        guest->loyalty_points += result->points;
+    }
+    result->id = op->id;
+    return ST_OK;
+}
+
+// Apply one operation to in-memory state; no prompts, output or logging
+OpStatus apply_operation(Operation *op, OpResult *result)
+{
+    memset(result, 0, sizeof(*result));
+    switch (op->type)
+    {
+    case OP_ADD_GUEST:
+        return apply_add_guest(&op->data.guest, result);
+    case OP_BOOK_ROOM:
+        return apply_book_room(&op->data.booking, op->room_version, result);
+    case OP_ASSIGN_PARKING:
+        return apply_assign_parking(&op->data.parking, result);
+    case OP_PROCESS_WAITLIST:
+        return apply_process_waitlist(result);
+    case OP_BOOK_FACILITY:
+        return apply_book_facility(&op->data.booking, result);
+    case OP_ORDER_SERVICE:
+        return apply_order_service(&op->data.service, result);
+    case OP_UPDATE_SERVICE:
+        return apply_update_service(&op->data.status, result);
+    case OP_REPORT_MAINTENANCE:
+        return apply_report_maintenance(&op->data.maintenance, result);
+    case OP_UPDATE_MAINTENANCE:
+        return apply_update_maintenance(&op->data.status, result);
+    case OP_SUBMIT_FEEDBACK:
+        return apply_submit_feedback(&op->data.feedback, result);
+    case OP_ADD_ITEM:
+        return apply_add_item(&op->data.item, result);
+    case OP_UPDATE_QUANTITY:
+        return apply_update_quantity(&op->data.quantity, result);
+    case OP_ADD_EVENT:
+        return apply_add_event(&op->data.event, result);
+    case OP_UPDATE_EVENT:
+        return apply_update_event(&op->data.status, result);
+    case OP_ADD_SCHEDULE:
+        return apply_add_schedule(&op->data.schedule, result);
+    case OP_UPDATE_SCHEDULE:
+        return apply_update_schedule(&op->data.schedule, result);
+    case OP_GENERATE_BILL:
+        return apply_generate_bill(&op->data.bill, result);
+    case OP_PROCESS_PAYMENT:
+        return apply_process_payment(&op->data.payment, result);
+    case OP_ADVANCE_CLOCK:
+        process_due_bookings(op->data.clock.date);
+        return ST_OK;
+    }
+    return ST_INVALID_CHOICE;
+}
+
+// Subsystem locks each operation needs
+unsigned int operation_locks[OP_TYPES] = {
+    [OP_ADD_GUEST] = 1u << LOCK_GUESTS,
+    [OP_BOOK_ROOM] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS,
+    [OP_ASSIGN_PARKING] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_PARKING,
+    [OP_PROCESS_WAITLIST] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_PARKING,
+    [OP_BOOK_FACILITY] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_FACILITIES,
+    [OP_ORDER_SERVICE] = 1u << LOCK_BOOKINGS | 1u << LOCK_SERVICES,
+    [OP_UPDATE_SERVICE] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_SERVICES,
+    [OP_REPORT_MAINTENANCE] = 1u << LOCK_MAINTENANCE,
+    [OP_UPDATE_MAINTENANCE] = 1u << LOCK_MAINTENANCE,
+    [OP_SUBMIT_FEEDBACK] = 1u << LOCK_GUESTS | 1u << LOCK_FEEDBACK,
+    [OP_ADD_ITEM] = 1u << LOCK_INVENTORY,
+    [OP_UPDATE_QUANTITY] = 1u << LOCK_INVENTORY,
+    [OP_ADD_EVENT] = 1u << LOCK_EVENTS,
+    [OP_UPDATE_EVENT] = 1u << LOCK_EVENTS,
+    [OP_ADD_SCHEDULE] = 1u << LOCK_SCHEDULES,
+    [OP_UPDATE_SCHEDULE] = 1u << LOCK_SCHEDULES,
+    [OP_GENERATE_BILL] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_BILLS,
+    [OP_PROCESS_PAYMENT] = 1u << LOCK_GUESTS | 1u << LOCK_BOOKINGS | 1u << LOCK_BILLS,
+    [OP_ADVANCE_CLOCK] = 1u << LOCK_BOOKINGS | 1u << LOCK_PARKING};
+
+// Take a set of subsystem locks in the global order, so operations cannot deadlock
+void lock_subsystems(unsigned int mask)
+{
+    int i;
+    for (i = 0; i < SUBSYSTEM_LOCKS; i++)
+    {
+        if (mask & (1u << i))
+            pthread_mutex_lock(&subsystem_locks[i]);
+    }
+}
+
+void unlock_subsystems(unsigned int mask)
+{
+    int i;
+    for (i = SUBSYSTEM_LOCKS - 1; i >= 0; i--)
+    {
+        if (mask & (1u << i))
+            pthread_mutex_unlock(&subsystem_locks[i]);
+    }
+}
+
+// Room shard an operation changes room state in: a room word, ROOM_WORDS for all, -1 for none.
+// Called with the operation's subsystem locks held, so the request table is stable.
+int operation_room_shard(Operation *op)
+{
+    int room_no = -1;
+    switch (op->type)
+    {
+    case OP_REPORT_MAINTENANCE:
+        room_no = op->data.maintenance.room_no;
+        break;
+    case OP_UPDATE_MAINTENANCE:
+    {
+        MaintenanceRequest *request = (MaintenanceRequest *)table_find(&maintenance, op->data.status.id);
+        if (request != NULL)
+            room_no = request->room_no;
+        break;
+    }
+    case OP_ADVANCE_CLOCK:
+        return ROOM_WORDS;
+    }
+    return room_no >= 1 && room_no <= MAX_ROOMS ? (room_no - 1) / 64 : -1;
+}
+
+// Take one room shard, or every shard in order
+void lock_room_shard(int shard)
+{
+    int w;
+    for (w = 0; w < ROOM_WORDS; w++)
+    {
+        if (shard == w || shard == ROOM_WORDS)
+            pthread_mutex_lock(&room_locks[w]);
+    }
+}
+
+void unlock_room_shard(int shard)
+{
+    int w;
+    for (w = ROOM_WORDS - 1; w >= 0; w--)
+    {
+        if (shard == w || shard == ROOM_WORDS)
+            pthread_mutex_unlock(&room_locks[w]);
+    }
+}
+
+// Bytes of the payload member used by an operation type (0 if unknown)
+size_t operation_payload_size(int type)
+{
+    switch (type)
+    {
+    case OP_ADD_GUEST:
+        return sizeof(GuestOp);
+    case OP_BOOK_ROOM:
+    case OP_BOOK_FACILITY:
+        return sizeof(BookingOp);
+    case OP_ASSIGN_PARKING:
+        return sizeof(ParkingOp);
+    case OP_PROCESS_WAITLIST:
+        return 0;
+    case OP_ORDER_SERVICE:
+        return sizeof(ServiceOrderOp);
+    case OP_UPDATE_SERVICE:
+    case OP_UPDATE_MAINTENANCE:
+    case OP_UPDATE_EVENT:
+        return sizeof(StatusOp);
+    case OP_PROCESS_PAYMENT:
+        return sizeof(PaymentOp);
+    case OP_REPORT_MAINTENANCE:
+        return sizeof(MaintenanceOp);
+    case OP_SUBMIT_FEEDBACK:
+        return sizeof(FeedbackOp);
+    case OP_ADD_ITEM:
+        return sizeof(ItemOp);
+    case OP_UPDATE_QUANTITY:
+        return sizeof(QuantityOp);
+    case OP_ADD_EVENT:
+        return sizeof(EventOp);
+    case OP_ADD_SCHEDULE:
+    case OP_UPDATE_SCHEDULE:
+        return sizeof(ScheduleOp);
+    case OP_GENERATE_BILL:
+        return sizeof(BillOp);
+    case OP_ADVANCE_CLOCK:
+        return sizeof(ClockOp);
+    }
+    return 0;
+}
+
+// Activity log line for an applied operation (empty if it is not audited)
+void describe_operation(Operation *op, OpResult *result, char *msg, size_t size)
+{
+    char *progress = op->data.status.choice == 1 ? "In Progress" : "Completed";
+    char from[SLOT_TEXT], to[SLOT_TEXT];
+    msg[0] = '\0';
+    switch (op->type)
+    {
+    case OP_ADD_GUEST:
+        snprintf(msg, size, "Added guest %s", op->data.guest.id);
+        break;
+    case OP_BOOK_ROOM:
+        snprintf(msg, size, "Booked room %d for guest %s", op->data.booking.room_no,
+                 op->data.booking.guest_id);
+        break;
+    case OP_ASSIGN_PARKING:
+        if (result->id != -1)
+            snprintf(msg, size, "Assigned parking slot %d to guest %s", result->id,
+                     op->data.parking.guest_id);
+        else
+            snprintf(msg, size, "Added guest %s to parking waitlist", op->data.parking.guest_id);
+        break;
+    case OP_PROCESS_WAITLIST:
+        snprintf(msg, size, "Assigned %d parking slots from waitlist", result->count);
+        break;
+    case OP_BOOK_FACILITY:
+        snprintf(msg, size, "Booked facility %s for guest %s from %s to %s",
+                 facility_name(op->data.booking.facility_id), op->data.booking.guest_id,
+                 format_slot(op->data.booking.slot, from),
+                 format_slot(op->data.booking.slot + op->data.booking.slots, to));
+        break;
+    case OP_ORDER_SERVICE:
+        snprintf(msg, size, "Ordered room service %s for room %d",
+                 service_items[op->data.service.item - 1], op->data.service.room_no);
+        break;
+    case OP_UPDATE_SERVICE:
+        snprintf(msg, size, "Updated service order %d status to %s", op->data.status.id, progress);
+        break;
+    case OP_REPORT_MAINTENANCE:
+        snprintf(msg, size, "Reported maintenance issue for room %d", op->data.maintenance.room_no);
+        break;
+    case OP_UPDATE_MAINTENANCE:
+        snprintf(msg, size, "Updated maintenance request %d status to %s", op->data.status.id,
+                 op->data.status.choice == 1 ? "In Progress" : "Resolved");
+        break;
+    case OP_SUBMIT_FEEDBACK:
+        snprintf(msg, size, "Guest %s submitted feedback with rating %d",
+                 op->data.feedback.guest_id, op->data.feedback.rating);
+        break;
+    case OP_ADD_ITEM:
+        snprintf(msg, size, "Added new inventory item");
+        break;
+    case OP_UPDATE_QUANTITY:
+        snprintf(msg, size, "Updated quantity for item %d", op->data.quantity.id);
+        break;
+    case OP_ADD_EVENT:
+        snprintf(msg, size, "Added event %s", op->data.event.name);
+        break;
+    case OP_UPDATE_EVENT:
+        snprintf(msg, size, "Updated event %d status", op->data.status.id);
+        break;
+    case OP_ADD_SCHEDULE:
+        snprintf(msg, size, "Added schedule for staff %s", op->data.schedule.staff_id);
+        break;
+    case OP_UPDATE_SCHEDULE:
+        snprintf(msg, size, "Updated schedule %d", op->data.schedule.id);
+        break;
+    case OP_GENERATE_BILL:
+        snprintf(msg, size, "Generated bill %d for guest %s", result->id, op->data.bill.guest_id);
+        break;
+    case OP_PROCESS_PAYMENT:
+        snprintf(msg, size, "Processed payment for bill %d", op->data.payment.id);
+        break;
+    }
+}
+
+// ======================== WRITE-AHEAD LOG OPERATIONS ========================
+
+// FNV-1a over a byte range
+unsigned int hash_bytes(const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    unsigned int hash = 2166136261u;
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Buffer a record for the next group commit; returns its LSN
+unsigned long long wal_append(Operation *op)
+{
+    if (wal_fd < 0)
+        return 0;
+    WalRecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.length = operation_payload_size(op->type);
+    header.checksum = hash_bytes(&op->data, header.length);
+    header.type = op->type;
+    pthread_mutex_lock(&wal_lock);
+    header.lsn = ++wal_last_lsn;
+    size_t needed = wal_buffer_used + sizeof(header) + header.length;
+    if (needed > wal_buffer_capacity)
+    {
+        wal_buffer_capacity = needed * 2;
+        wal_buffer = (char *)realloc(wal_buffer, wal_buffer_capacity);
+    }
+    memcpy(wal_buffer + wal_buffer_used, &header, sizeof(header));
+    memcpy(wal_buffer + wal_buffer_used + sizeof(header), &op->data, header.length);
+    wal_buffer_used = needed;
+    pthread_cond_signal(&wal_work);
+    pthread_mutex_unlock(&wal_lock);
+    return header.lsn;
+}
+
+// Whether the log has failed; nothing applied after that point could be made durable
+int wal_failed()
+{
+    pthread_mutex_lock(&wal_lock);
+    int failed = wal_error;
+    pthread_mutex_unlock(&wal_lock);
+    return failed;
+}
+
+// Block until the record with this LSN is on disk; returns 0 if the log has failed instead
+int wal_commit(unsigned long long lsn)
+{
+    if (wal_fd < 0)
+        return 1;
+    pthread_mutex_lock(&wal_lock);
+    while (wal_durable_lsn < lsn && !wal_error)
+        pthread_cond_wait(&wal_synced, &wal_lock);
+    int durable = wal_durable_lsn >= lsn;
+    pthread_mutex_unlock(&wal_lock);
+    return durable;
+}
+
+// Flusher thread: write whatever accumulated during the previous fsync as one group.
+// After a failed write or sync, later groups are dropped: records past a torn one never replay.
+void *wal_flusher_main(void *arg)
+{
+    pthread_mutex_lock(&wal_lock);
+    while (1)
+    {
+        while (wal_running && wal_buffer_used == 0)
+            pthread_cond_wait(&wal_work, &wal_lock);
+        if (wal_buffer_used == 0)
+            break;
+        char *batch = wal_buffer;
+        size_t batch_size = wal_buffer_used, batch_capacity = wal_buffer_capacity;
+        unsigned long long batch_lsn = wal_last_lsn;
+        int ok = !wal_error;
+        wal_buffer = wal_spare;
+        wal_buffer_capacity = wal_spare_capacity;
+        wal_buffer_used = 0;
+        pthread_mutex_unlock(&wal_lock);
+
+        size_t written = 0;
+        while (ok && written < batch_size)
+        {
+            ssize_t n = write(wal_fd, batch + written, batch_size - written);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+            {
+                perror("write-ahead log");
+                ok = 0;
+            }
+            else
+                written += n;
+        }
+        if (ok && fdatasync(wal_fd) != 0)
+        {
+            perror("write-ahead log sync");
+            ok = 0;
+        }
+
+        pthread_mutex_lock(&wal_lock);
+        wal_spare = batch;
+        wal_spare_capacity = batch_capacity;
+        if (ok)
+            wal_durable_lsn = batch_lsn;
+        else
+            wal_error = 1;
+        pthread_cond_broadcast(&wal_synced);
+    }
+    pthread_mutex_unlock(&wal_lock);
+    return NULL;
+}
+
+// Replay records newer than the loaded snapshot, drop any torn tail, start the flusher
+int open_wal(const char *path)
+{
+    wal_fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (wal_fd < 0)
+    {
+        perror(path);
+        return 0;
+    }
+    struct stat st;
+    if (fstat(wal_fd, &st) != 0)
+    {
+        perror(path);
+        close(wal_fd);
+        wal_fd = -1;
+        return 0;
+    }
+    off_t good = 0;
+    int replayed = 0;
+    if (st.st_size > 0)
+    {
+        char *map = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, wal_fd, 0);
+        while (map != MAP_FAILED && good + (off_t)sizeof(WalRecordHeader) <= st.st_size)
+        {
+            WalRecordHeader header;
+            memcpy(&header, map + good, sizeof(header));
+            off_t end = good + sizeof(header) + header.length;
+            if (header.type <= 0 || header.type >= OP_TYPES ||
+                header.length != operation_payload_size(header.type) || end > st.st_size ||
+                hash_bytes(map + good + sizeof(header), header.length) != header.checksum)
+                break;
+            if (header.lsn > wal_last_lsn)
+            {
+                Operation op;
+                OpResult result;
+                op.type = header.type;
+                op.room_version = ROOM_REPLAYED;
+                memcpy(&op.data, map + good + sizeof(header), header.length);
+                if (apply_operation(&op, &result) != ST_OK)
+                    printf("Warning: write-ahead log record %llu did not reapply\n", header.lsn);
+                wal_last_lsn = header.lsn;
+                replayed++;
+            }
+            good = end;
+        }
+        if (map != MAP_FAILED)
+            munmap(map, st.st_size);
+        // Appends after a torn tail would never replay, so failing to cut it fails the log
+        if (good < st.st_size && ftruncate(wal_fd, good) != 0)
+        {
+            perror(path);
+            wal_error = 1;
+        }
+    }
+    if (replayed > 0)
+        printf("Recovered %d operations from %s\n", replayed, path);
+    wal_durable_lsn = wal_last_lsn;
+    wal_running = 1;
+    pthread_create(&wal_flusher, NULL, wal_flusher_main, NULL);
+    return 1;
+}
+
+// Stop the flusher after it has synced every buffered record
+void close_wal()
+{
+    if (wal_fd < 0)
+        return;
+    pthread_mutex_lock(&wal_lock);
+    wal_running = 0;
+    pthread_cond_signal(&wal_work);
+    pthread_mutex_unlock(&wal_lock);
+    pthread_join(wal_flusher, NULL);
+}
+
+// Save a snapshot and start an empty log; records stay on disk if the snapshot fails
+int checkpoint()
+{
+    if (!save_snapshot(SNAPSHOT_FILE))
+        return 0;
+    // Records the snapshot covers are skipped by LSN at replay, so a failed truncate only wastes space
+    if (wal_fd >= 0 && ftruncate(wal_fd, 0) != 0)
+        perror(WAL_FILE);
+    return 1;
+}
+
+// Apply, make durable, then audit; used by every interactive and server mutation.
+// Records are appended before the locks drop, so operations that touch the same state
+// reach the log in the order they were applied; the fsync wait happens unlocked.
+// A room booking takes its nights first, gated only by the room version CAS, so the
+// subsystem locks cover just the booking tree insert and the ID sequence.
+OpStatus execute_operation(char *user_id, Operation *op, OpResult *result)
+{
+    OpResult scratch;
+    if (result == NULL)
+        result = &scratch;
+    if (wal_failed())
+        return ST_IO_ERROR;
+    if (op->type == OP_BOOK_ROOM)
+    {
+        OpStatus reserved = reserve_room_booking(&op->data.booking, op->room_version);
+        if (reserved != ST_OK)
+            return reserved;
+        op->room_version = ROOM_RESERVED;
+    }
+    unsigned int locks = operation_locks[op->type];
+    lock_subsystems(locks);
+    int shard = operation_room_shard(op);
+    lock_room_shard(shard);
+    OpStatus status = apply_operation(op, result);
+    unsigned long long lsn = status == ST_OK ? wal_append(op) : 0;
+    unlock_room_shard(shard);
+    unlock_subsystems(locks);
+    if (status != ST_OK)
+        return status;
+    if (!wal_commit(lsn))
+        return ST_IO_ERROR;
+    char msg[100];
+    describe_operation(op, result, msg, sizeof(msg));
+    if (msg[0] != '\0')
+        log_activity(user_id, msg);
+    return status;
+}
+
+// Fire due booking transitions, logged so replay fires them at the same point
+void advance_clock(Date current)
+{
+    pthread_mutex_lock(&subsystem_locks[LOCK_BOOKINGS]);
+    int due = booking_event_count > 0 && booking_events[0].day <= calendar_day(current);
+    pthread_mutex_unlock(&subsystem_locks[LOCK_BOOKINGS]);
+    if (!due)
+        return;
+    Operation op = {.type = OP_ADVANCE_CLOCK};
+    op.data.clock.date = current;
+    execute_operation("system", &op, NULL);
+}
+
+// ======================== BATCH OPERATIONS ========================
+
+BatchCommand batch_commands[] = {
+    {"guest", OP_ADD_GUEST, 4, 5},
+    {"book", OP_BOOK_ROOM, 4, 5},
+    {"park", OP_ASSIGN_PARKING, 2, 2},
+    {"waitlist", OP_PROCESS_WAITLIST, 0, 0},
+    {"facility", OP_BOOK_FACILITY, 3, 5},
+    {"service", OP_ORDER_SERVICE, 2, 3},
+    {"service-status", OP_UPDATE_SERVICE, 2, 2},
+    {"maintenance", OP_REPORT_MAINTENANCE, 4, 5},
+    {"maintenance-status", OP_UPDATE_MAINTENANCE, 2, 2},
+    {"feedback", OP_SUBMIT_FEEDBACK, 3, 4},
+    {"item", OP_ADD_ITEM, 5, 5},
+    {"quantity", OP_UPDATE_QUANTITY, 2, 2},
+    {"event", OP_ADD_EVENT, 7, 7},
+    {"event-status", OP_UPDATE_EVENT, 2, 2},
+    {"schedule", OP_ADD_SCHEDULE, 4, 4},
+    {"schedule-update", OP_UPDATE_SCHEDULE, 3, 3},
+    {"bill", OP_GENERATE_BILL, 2, 3},
+    {"pay", OP_PROCESS_PAYMENT, 2, 3},
+    {"clock", OP_ADVANCE_CLOCK, 1, 1}};
+
+// Split a line on tabs in place; returns the field count
+int split_batch_fields(char *line, char *fields[], int max)
+{
+    int count = 0;
+    line[strcspn(line, "\r\n")] = '\0';
+    while (count < max)
+    {
+        fields[count++] = line;
+        char *tab = strchr(line, '\t');
+        if (tab == NULL)
+            break;
+        *tab = '\0';
+        line = tab + 1;
+    }
+    return count;
+}
+
+// Copy a field, truncating to the destination size
+void copy_field(char *dst, size_t size, const char *src)
+{
+    snprintf(dst, size, "%s", src);
+}
+
+// Parse dd/mm/yyyy; validity is left to the operation
+int parse_batch_date(const char *text, Date *date)
+{
+    int day, month, year;
+    if (sscanf(text, "%d/%d/%d", &day, &month, &year) != 3)
+        return 0;
+    *date = make_date(day, month, year);
+    return 1;
+}
+
+// Parse a room version from check; versions handed out are even, so odd values (the ROOM_ sentinels) are refused
+int parse_room_version(const char *text, unsigned int *version)
+{
+    char *end;
+    errno = 0;
+    unsigned long value = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || value > 0xFFFFFFFFul || (value & 1))
+        return 0;
+    *version = (unsigned int)value;
+    return 1;
+}
+
+// Fill an operation from a command's fields (fields[0] is the command name)
+int parse_batch_operation(char *fields[], int count, Operation *op)
+{
+    int i;
+    BatchCommand *command = NULL;
+    for (i = 0; i < (int)(sizeof(batch_commands) / sizeof(batch_commands[0])); i++)
+    {
+        if (strcmp(fields[0], batch_commands[i].name) == 0)
+        {
+            command = &batch_commands[i];
+            break;
+        }
+    }
+    if (command == NULL || count - 1 < command->min_fields || count - 1 > command->max_fields)
+        return 0;
+    char **f = fields + 1;
+    int optional = count - 1 > command->min_fields;
+    memset(op, 0, sizeof(*op));
+    op->type = command->type;
+    switch (op->type)
+    {
+    case OP_ADD_GUEST:
+        copy_field(op->data.guest.id, MAX_ID, f[0]);
+        copy_field(op->data.guest.name, MAX_NAME, f[1]);
+        copy_field(op->data.guest.contact, sizeof(op->data.guest.contact), f[2]);
+        copy_field(op->data.guest.email, sizeof(op->data.guest.email), f[3]);
+        if (optional)
+            copy_field(op->data.guest.preferences, sizeof(op->data.guest.preferences), f[4]);
+        return 1;
+    case OP_BOOK_ROOM:
+        copy_field(op->data.booking.guest_id, MAX_ID, f[0]);
+        op->data.booking.room_no = atoi(f[1]);
+        op->data.booking.facility_id = -1;
+        op->room_version = ROOM_UNCHECKED;
+        if (optional && !parse_room_version(f[4], &op->room_version))
+            return 0;
+        return parse_batch_date(f[2], &op->data.booking.check_in) &&
+               parse_batch_date(f[3], &op->data.booking.check_out);
+    case OP_ASSIGN_PARKING:
+        copy_field(op->data.parking.guest_id, MAX_ID, f[0]);
+        copy_field(op->data.parking.vehicle, sizeof(op->data.parking.vehicle), f[1]);
+        return 1;
+    case OP_PROCESS_WAITLIST:
+        return 1;
+    case OP_BOOK_FACILITY:
+        op->data.booking.facility_id = atoi(f[0]);
+        copy_field(op->data.booking.guest_id, MAX_ID, f[1]);
+        op->data.booking.room_no = -1;
+        if (!parse_batch_date(f[2], &op->data.booking.check_in))
+            return 0;
+        op->data.booking.check_out = op->data.booking.check_in;
+        // Without a start time the whole day is booked; with one, a single slot by default
+        op->data.booking.slots = SLOTS_PER_DAY;
+        if (optional)
+        {
+            op->data.booking.slot = parse_slot_time(f[3]);
+            op->data.booking.slots = count - 1 > 4 ? slots_for_minutes(atoi(f[4])) : 1;
+        }
+        return 1;
+    case OP_ORDER_SERVICE:
+        op->data.service.room_no = atoi(f[0]);
+        op->data.service.item = atoi(f[1]);
+        if (optional)
+            copy_field(op->data.service.time, sizeof(op->data.service.time), f[2]);
+        else
+            get_current_time(op->data.service.time);
+        return 1;
+    case OP_UPDATE_SERVICE:
+    case OP_UPDATE_MAINTENANCE:
+    case OP_UPDATE_EVENT:
+        op->data.status.id = atoi(f[0]);
+        op->data.status.choice = atoi(f[1]);
+        return 1;
+    case OP_PROCESS_PAYMENT:
+        op->data.payment.id = atoi(f[0]);
+        op->data.payment.method = atoi(f[1]);
+        if (!optional)
+        {
+            op->data.payment.date = get_current_date();
+            return 1;
+        }
+        return parse_batch_date(f[2], &op->data.payment.date);
+    case OP_REPORT_MAINTENANCE:
+        op->data.maintenance.room_no = atoi(f[0]);
+        op->data.maintenance.issue_type = atoi(f[1]);
+        op->data.maintenance.priority = atoi(f[2]);
+        copy_field(op->data.maintenance.description, sizeof(op->data.maintenance.description), f[3]);
+        if (!optional)
+        {
+            op->data.maintenance.date = get_current_date();
+            return 1;
+        }
+        return parse_batch_date(f[4], &op->data.maintenance.date);
+    case OP_SUBMIT_FEEDBACK:
+        copy_field(op->data.feedback.guest_id, MAX_ID, f[0]);
+        op->data.feedback.rating = atoi(f[1]);
+        copy_field(op->data.feedback.comment, sizeof(op->data.feedback.comment), f[2]);
+        if (!optional)
+        {
+            op->data.feedback.date = get_current_date();
+            return 1;
+        }
+        return parse_batch_date(f[3], &op->data.feedback.date);
+    case OP_ADD_ITEM:
+        copy_field(op->data.item.name, sizeof(op->data.item.name), f[0]);
+        copy_field(op->data.item.category, sizeof(op->data.item.category), f[1]);
+        op->data.item.quantity = atoi(f[2]);
+        op->data.item.unit_price = atof(f[3]);
+        op->data.item.reorder_level = atoi(f[4]);
+        return 1;
+    case OP_UPDATE_QUANTITY:
+        op->data.quantity.id = atoi(f[0]);
+        op->data.quantity.quantity = atoi(f[1]);
+        return 1;
+    case OP_ADD_EVENT:
+        copy_field(op->data.event.name, sizeof(op->data.event.name), f[0]);
+        copy_field(op->data.event.time, sizeof(op->data.event.time), f[2]);
+        op->data.event.facility_id = atoi(f[3]);
+        copy_field(op->data.event.organizer, MAX_NAME, f[4]);
+        op->data.event.capacity = atoi(f[5]);
+        op->data.event.cost = atof(f[6]);
+        return parse_batch_date(f[1], &op->data.event.date);
+    case OP_ADD_SCHEDULE:
+        copy_field(op->data.schedule.staff_id, MAX_ID, f[0]);
+        copy_field(op->data.schedule.shift, sizeof(op->data.schedule.shift), f[2]);
+        copy_field(op->data.schedule.task, sizeof(op->data.schedule.task), f[3]);
+        return parse_batch_date(f[1], &op->data.schedule.date);
+    case OP_UPDATE_SCHEDULE:
+        op->data.schedule.id = atoi(f[0]);
+        copy_field(op->data.schedule.shift, sizeof(op->data.schedule.shift), f[1]);
+        copy_field(op->data.schedule.task, sizeof(op->data.schedule.task), f[2]);
+        return 1;
+    case OP_GENERATE_BILL:
+        copy_field(op->data.bill.guest_id, MAX_ID, f[0]);
+        copy_field(op->data.bill.booking_id, sizeof(op->data.bill.booking_id), f[1]);
+        if (!optional)
+        {
+            op->data.bill.date = get_current_date();
+            return 1;
+        }
+        return parse_batch_date(f[2], &op->data.bill.date);
+    case OP_ADVANCE_CLOCK:
+        return parse_batch_date(f[0], &op->data.clock.date);
+    }
+    return 0;
+}
+
+// Apply a command stream without prompts; one fsync wait covers the whole batch
+// Returns 0 if the applied records could not be made durable
+int run_batch(FILE *input, char *user_id)
+{
+    char line[BATCH_LINE];
+    char *fields[BATCH_MAX_FIELDS];
+    long line_no = 0, records = 0, applied = 0, failed = 0, unparsed = 0;
+    long failures[ST_STATUSES] = {0};
+    unsigned long long last_lsn = 0;
+    int i;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        line_no++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r' || line[0] == '\0')
+            continue;
+        records++;
+        Operation op;
+        OpResult result;
+        int count = split_batch_fields(line, fields, BATCH_MAX_FIELDS);
+        if (!parse_batch_operation(fields, count, &op))
+        {
+            fprintf(stderr, "line %ld: unrecognised command or fields\n", line_no);
+            unparsed++;
+            continue;
+        }
+        OpStatus status = wal_failed() ? ST_IO_ERROR : apply_operation(&op, &result);
+        if (status != ST_OK)
+        {
+            fprintf(stderr, "line %ld: %s\n", line_no, status_messages[status]);
+            failures[status]++;
+            failed++;
+            continue;
+        }
+        last_lsn = wal_append(&op);
+        applied++;
+    }
+    advance_clock(get_current_date());
+    int durable = wal_commit(last_lsn);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("\n=== BATCH SUMMARY ===\n");
+    printf("Records: %ld\nApplied: %ld\nFailed: %ld\nUnparsed: %ld\n",
+           records, applied, failed, unparsed);
+    for (i = 1; i < ST_STATUSES; i++)
+    {
+        if (failures[i] > 0)
+            printf("  %-45s %ld\n", status_messages[i], failures[i]);
+    }
+    printf("Elapsed: %.3f s (%.0f records/s)\n", seconds,
+           seconds > 0 ? records / seconds : 0.0);
+    printf("Guests: %d, Bookings: %d, Revenue: $%.2f\n", guest_count, booking_count, total_revenue);
+    char log_msg[100];
+    sprintf(log_msg, "Batch applied %ld of %ld records", applied, records);
+    log_activity(user_id, log_msg);
+    if (!durable)
+        fprintf(stderr, "%s\n", status_messages[ST_IO_ERROR]);
+    return durable;
+}
+
+// ======================== SERVER OPERATIONS ========================
+
+// Queue a connection for the workers; caller holds the connection's lock
+void push_ready_connection(Connection *conn)
+{
+    conn->queued = 1;
+    conn->next_ready = NULL;
+    pthread_mutex_lock(&ready_lock);
+    if (ready_tail != NULL)
+        ready_tail->next_ready = conn;
+    else
+        ready_head = conn;
+    ready_tail = conn;
+    pthread_cond_signal(&ready_work);
+    pthread_mutex_unlock(&ready_lock);
+}
+
+// Next connection to serve; NULL once the server is stopping and the queue is drained
+Connection *pop_ready_connection()
+{
+    pthread_mutex_lock(&ready_lock);
+    while (server_running && ready_head == NULL)
+        pthread_cond_wait(&ready_work, &ready_lock);
+    Connection *conn = ready_head;
+    if (conn != NULL)
+    {
+        ready_head = conn->next_ready;
+        if (ready_head == NULL)
+            ready_tail = NULL;
+    }
+    pthread_mutex_unlock(&ready_lock);
+    return conn;
+}
+
+Connection *open_connection(int fd)
+{
+    Connection *conn = (Connection *)calloc(1, sizeof(Connection));
+    conn->fd = fd;
+    pthread_mutex_init(&conn->lock, NULL);
+    pthread_mutex_lock(&ready_lock);
+    conn->next = connection_list;
+    if (connection_list != NULL)
+        connection_list->prev = conn;
+    connection_list = conn;
+    pthread_mutex_unlock(&ready_lock);
+    metric_add(&server_connections, 1);
+    return conn;
+}
+
+void free_connection(Connection *conn)
+{
+    pthread_mutex_lock(&ready_lock);
+    if (conn->prev != NULL)
+        conn->prev->next = conn->next;
+    else
+        connection_list = conn->next;
+    if (conn->next != NULL)
+        conn->next->prev = conn->prev;
+    pthread_mutex_unlock(&ready_lock);
+    close(conn->fd);
+    pthread_mutex_destroy(&conn->lock);
+    free(conn);
+}
+
+// Move the next complete line out of the input buffer; on none, release the connection
+int take_connection_line(Connection *conn, char *line, size_t size)
+{
+    pthread_mutex_lock(&conn->lock);
+    char *newline = (char *)memchr(conn->input, '\n', conn->input_used);
+    if (newline == NULL)
+    {
+        int release = conn->closed;
+        conn->queued = 0;
+        pthread_mutex_unlock(&conn->lock);
+        if (release)
+            free_connection(conn);
+        return 0;
+    }
+    size_t length = newline - conn->input;
+    snprintf(line, size, "%.*s", (int)length, conn->input);
+    conn->input_used -= length + 1;
+    memmove(conn->input, newline + 1, conn->input_used);
+    pthread_mutex_unlock(&conn->lock);
+    return 1;
+}
+
+// Write a whole reply line, waiting out a full socket buffer
+void send_reply(int fd, const char *reply)
+{
+    size_t length = strlen(reply), sent = 0;
+    while (sent < length)
+    {
+        ssize_t n = send(fd, reply + sent, length - sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            sent += n;
+            continue;
+        }
+        if (n < 0 && errno == EAGAIN)
+        {
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            if (poll(&pfd, 1, 1000) > 0)
+                continue;
+        }
+        return; // Client gone or stalled; drop the reply
+    }
+}
+
+// Run one protocol line and format its reply
+void serve_request(char *line, char *reply, size_t size)
+{
+    char *fields[BATCH_MAX_FIELDS];
+    Operation op;
+    OpResult result;
+    int count = split_batch_fields(line, fields, BATCH_MAX_FIELDS);
+    metric_add(&server_requests, 1);
+    if (strcmp(fields[0], "stats") == 0)
+    {
+        snprintf(reply, size,
+                 "OK\trooms_occupied=%ld\tbookings_upcoming=%ld\tbookings_active=%ld"
+                 "\tservices_pending=%ld\tmaintenance_open=%ld\tparking_occupied=%ld\n",
+                 metric_get(&metrics.rooms_occupied), metric_get(&metrics.bookings_upcoming),
+                 metric_get(&metrics.bookings_active), metric_get(&metrics.services_pending),
+                 metric_get(&metrics.maintenance_open), metric_get(&metrics.parking_occupied));
+        return;
+    }
+    if (strcmp(fields[0], "check") == 0 && count == 4)
+    {
+        // Availability without locks; pass the version to book to commit only if nothing changed
+        Date ci, co;
+        unsigned int version;
+        int room_no = atoi(fields[1]);
+        if (!parse_batch_date(fields[2], &ci) || !parse_batch_date(fields[3], &co) ||
+            !is_valid_date(ci) || !is_valid_date(co) || date_diff(ci, co) <= 0)
+            snprintf(reply, size, "ERR\t%s\n", status_messages[ST_INVALID_DATES]);
+        else if (room_no < 1 || room_no > MAX_ROOMS || !check_room_availability(room_no, ci, co, &version))
+            snprintf(reply, size, "ERR\t%s\n", status_messages[ST_ROOM_UNAVAILABLE]);
+        else
+            snprintf(reply, size, "OK\tversion=%u\trate=%.2f\n", version, rooms.price[room_no - 1]);
+        return;
+    }
+    if (strcmp(fields[0], "nearest") == 0 && count >= 3 && count <= 6)
+    {
+        // Nearest facility of the listed types from a room's floor with places at a time:
+        // the current half hour by default, the whole day for a date alone
+        int room_no = atoi(fields[1]);
+        FacilityDistance nearest = {INFINITY, -1};
+        char now[10];
+        get_current_time(now);
+        Date date = get_current_date();
+        int slot = parse_slot_time(now), slots = 1;
+        if (count > 3)
+        {
+            slot = 0;
+            slots = SLOTS_PER_DAY;
+            if (!parse_batch_date(fields[3], &date))
+                date = DATE_INVALID;
+        }
+        if (count > 4)
+        {
+            slot = parse_slot_time(fields[4]);
+            slots = 1;
+        }
+        if (count > 5)
+            slots = slots_for_minutes(atoi(fields[5]));
+        if (!is_valid_date(date) || !valid_slot_range(slot, slots))
+        {
+            OpStatus status = is_valid_date(date) ? ST_INVALID_SLOT : ST_INVALID_DATE;
+            snprintf(reply, size, "ERR\t%s\n", status_messages[status]);
+            return;
+        }
+        if (room_no >= 1 && room_no <= MAX_ROOMS)
+        {
+            pthread_mutex_lock(&subsystem_locks[LOCK_FACILITIES]);
+            FacilityDistance *found = nearest_facility(room_node(room_no), fields[2], date, slot, slots);
+            if (found != NULL)
+                nearest = *found;
+            pthread_mutex_unlock(&subsystem_locks[LOCK_FACILITIES]);
+        }
+        if (nearest.facility < 0)
+            snprintf(reply, size, "ERR\t%s\n", status_messages[ST_FACILITY_UNAVAILABLE]);
+        else
+            snprintf(reply, size, "OK\tfacility=%d\tname=%s\tmetres=%.0f\n", nearest.facility + 1,
+                     facilities[nearest.facility].name, nearest.metres);
+        return;
+    }
+    if (strcmp(fields[0], "slots") == 0 && count >= 3 && count <= 4)
+    {
+        // Free times of one facility for a run of days (a week by default)
+        int i, facility_id = atoi(fields[1]);
+        int days = count > 3 ? atoi(fields[3]) : FREE_SLOTS_DAYS;
+        Date date;
+        if (facility_id < 1 || facility_id > facility_count)
+            snprintf(reply, size, "ERR\t%s\n", status_messages[ST_INVALID_FACILITY]);
+        else if (!parse_batch_date(fields[2], &date) || !is_valid_date(date))
+            snprintf(reply, size, "ERR\t%s\n", status_messages[ST_INVALID_DATE]);
+        else
+        {
+            char text[FREE_SLOTS_TEXT], date_text[DATE_TEXT];
+            int used = snprintf(reply, size, "OK");
+            pthread_mutex_lock(&subsystem_locks[LOCK_FACILITIES]);
+            for (i = 0; i < days && i < FREE_SLOTS_DAYS && is_valid_date(date + i); i++)
+                used += snprintf(reply + used, size - used, "\t%s=%s", format_date(date + i, date_text),
+                                 format_free_slots(facility_id - 1, date + i, text, sizeof(text)));
+            pthread_mutex_unlock(&subsystem_locks[LOCK_FACILITIES]);
+            snprintf(reply + used, size - used, "\n");
+        }
+        return;
+    }
+    if (!parse_batch_operation(fields, count, &op))
+    {
+        snprintf(reply, size, "ERR\tunrecognised command or fields\n");
+        return;
+    }
+    OpStatus status = execute_operation("server", &op, &result);
+    if (status != ST_OK)
+    {
+        snprintf(reply, size, "ERR\t%s\n", status_messages[status]);
+        return;
+    }
+    int used = snprintf(reply, size, "OK");
+    if (result.booking != NULL)
+        used += snprintf(reply + used, size - used, "\tbooking=%s\ttotal=%.2f",
+                         result.booking->booking_id, result.booking->total);
+    else if (op.type == OP_ASSIGN_PARKING && result.id == -1)
+        used += snprintf(reply + used, size - used, "\twaitlisted");
+    else if (result.id > 0)
+        used += snprintf(reply + used, size - used, "\tid=%d", result.id);
+    if (op.type == OP_PROCESS_WAITLIST)
+        used += snprintf(reply + used, size - used, "\tplaced=%d", result.count);
+    if (result.points > 0)
+        used += snprintf(reply + used, size - used, "\tpoints=%d", result.points);
+    snprintf(reply + used, size - used, "\n");
+}
+
+// Worker thread: serve queued connections line by line until shutdown
+void *server_worker_main(void *arg)
+{
+    char line[BATCH_LINE], reply[SERVER_REPLY];
+    Connection *conn;
+    while ((conn = pop_ready_connection()) != NULL)
+    {
+        while (take_connection_line(conn, line, sizeof(line)))
+        {
+            serve_request(line, reply, sizeof(reply));
+            send_reply(conn->fd, reply);
+        }
+    }
+    return NULL;
+}
+
+// Pull everything readable into the connection's buffer and queue any complete lines
+void read_connection(int epoll_fd, Connection *conn)
+{
+    int hangup = 0;
+    pthread_mutex_lock(&conn->lock);
+    while (1)
+    {
+        if (conn->input_used == SERVER_BUFFER)
+        {
+            hangup = 1; // A line longer than the buffer can never complete
+            break;
+        }
+        ssize_t n = read(conn->fd, conn->input + conn->input_used, SERVER_BUFFER - conn->input_used);
+        if (n > 0)
+        {
+            conn->input_used += n;
+            continue;
+        }
+        if (n == 0 || errno != EAGAIN)
+            hangup = 1;
+        break;
+    }
+    if (!conn->queued && memchr(conn->input, '\n', conn->input_used) != NULL)
+        push_ready_connection(conn);
+    int release = 0;
+    if (hangup)
+    {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+        conn->closed = 1;
+        release = !conn->queued;
+    }
+    pthread_mutex_unlock(&conn->lock);
+    if (release)
+        free_connection(conn);
+}
+
+void server_stop_signal(int signo)
+{
+    char byte = 0;
+    if (write(server_stop_pipe[1], &byte, 1) < 0)
+        return;
+}
+
+// Serve the batch command protocol on a Unix socket until SIGINT or SIGTERM
+void run_server(const char *path)
+{
+    struct sockaddr_un addr;
+    int i;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        printf("Socket path too long: %s\n", path);
+        return;
+    }
+    strcpy(addr.sun_path, path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(path);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(listen_fd, SOMAXCONN) < 0)
+    {
+        perror(path);
+        if (listen_fd >= 0)
+            close(listen_fd);
+        return;
+    }
+    if (pipe2(server_stop_pipe, O_NONBLOCK | O_CLOEXEC) < 0)
+    {
+        perror("pipe");
+        close(listen_fd);
+        return;
+    }
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = server_stop_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL; // Listener
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.ptr = server_stop_pipe;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, server_stop_pipe[0], &event);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int worker_count = (cpus > 0 ? (int)cpus : 1) * SERVER_WORKERS_PER_CPU;
+    pthread_t *workers = (pthread_t *)malloc(worker_count * sizeof(pthread_t));
+    server_running = 1;
+    for (i = 0; i < worker_count; i++)
+        pthread_create(&workers[i], NULL, server_worker_main, NULL);
+    printf("Serving on %s with %d workers\n", path, worker_count);
+    fflush(stdout);
+
+    struct epoll_event ready[SERVER_EVENTS];
+    int stopping = 0;
+    while (!stopping)
+    {
+        int n = epoll_wait(epoll_fd, ready, SERVER_EVENTS, 1000);
+        for (i = 0; i < n; i++)
+        {
+            if (ready[i].data.ptr == server_stop_pipe)
+            {
+                stopping = 1;
+            }
+            else if (ready[i].data.ptr == NULL)
+            {
+                int fd;
+                while ((fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                {
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.ptr = open_connection(fd);
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+                }
+            }
+            else
+            {
+                read_connection(epoll_fd, (Connection *)ready[i].data.ptr);
+            }
+        }
+        advance_clock(get_current_date());
+    }
+
+    // Finish queued requests, then drop whatever connections remain
+    close(listen_fd);
+    unlink(path);
+    pthread_mutex_lock(&ready_lock);
+    server_running = 0;
+    pthread_cond_broadcast(&ready_work);
+    pthread_mutex_unlock(&ready_lock);
+    for (i = 0; i < worker_count; i++)
+        pthread_join(workers[i], NULL);
+    free(workers);
+    while (connection_list != NULL)
+        free_connection(connection_list);
+    close(epoll_fd);
+    close(server_stop_pipe[0]);
+    close(server_stop_pipe[1]);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    printf("Served %ld requests from %ld connections\n", metric_get(&server_requests),
+           metric_get(&server_connections));
+    char log_msg[100];
+    sprintf(log_msg, "Server handled %ld requests", metric_get(&server_requests));
+    log_activity("server", log_msg);
+}
+
+// ======================== BENCHMARK OPERATIONS ========================
+
+// Monotonic clock in nanoseconds
+long long now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Deterministic xorshift generator so runs are comparable
+unsigned long long bench_random(unsigned long long *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+int compare_latency(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Print one JSON line with throughput and latency percentiles
+void report_benchmark(const char *name, long records, long long *latencies, long ops,
+                      long long elapsed_ns)
+{
+    qsort(latencies, ops, sizeof(long long), compare_latency);
+    printf("{\"benchmark\":\"%s\",\"records\":%ld,\"ops\":%ld,\"seconds\":%.6f,"
+           "\"ops_per_sec\":%.0f,\"p50_ns\":%lld,\"p90_ns\":%lld,\"p99_ns\":%lld,"
+           "\"p999_ns\":%lld,\"max_ns\":%lld}\n",
+           name, records, ops, elapsed_ns / 1e9, ops / (elapsed_ns / 1e9),
+           latencies[ops / 2], latencies[(long)(ops * 0.9)], latencies[(long)(ops * 0.99)],
+           latencies[(long)(ops * 0.999)], latencies[ops - 1]);
+    fflush(stdout);
+}
+
+// Synthetic stay of one to three nights in BENCH_YEAR
+void bench_stay(unsigned long long *rng, Date *ci, Date *co)
+{
+    int month = bench_random(rng) % 12 + 1;
+    *ci = make_date(bench_random(rng) % 25 + 1, month, BENCH_YEAR);
+    *co = *ci + bench_random(rng) % 3 + 1;
+}
+
+// Insert, look up and bill against a fresh data set of the given size; 0 if it does not fit
+int run_benchmarks(long records)
+{
+    long i;
+    long lookups = records < BENCH_LOOKUPS ? records : BENCH_LOOKUPS;
+    long long *latencies = (long long *)malloc(records * sizeof(long long));
+    BookingNode **bookings = (BookingNode **)malloc(records * sizeof(BookingNode *));
+    if (latencies == NULL || bookings == NULL)
+    {
+        fprintf(stderr, "Benchmark error: cannot allocate %ld records\n", records);
+        free(latencies);
+        free(bookings);
+        return 0;
+    }
+    unsigned long long rng = 88172645463325252ULL;
+    char key[MAX_ID];
+    long long start, t;
+
+    Guest guest;
+    memset(&guest, 0, sizeof(guest));
+    strcpy(guest.name, "Bench Guest");
+    strcpy(guest.contact, "5550100");
+    strcpy(guest.email, "bench@example.com");
+    start = now_ns();
+    for (i = 0; i < records; i++)
+    {
+        snprintf(guest.id, MAX_ID, "G%d", (int)i);
+        t = now_ns();
+        add_guest_to_list(&guest_list, guest);
+        latencies[i] = now_ns() - t;
+    }
+    report_benchmark("add_guest_to_list", records, latencies, records, now_ns() - start);
+
+    start = now_ns();
+    for (i = 0; i < records; i++)
+    {
+        Date ci, co;
+        bench_stay(&rng, &ci, &co);
+        snprintf(key, MAX_ID, "G%d", (int)i);
+        t = now_ns();
+        bookings[i] = new_booking_node(key, i % MAX_ROOMS + 1, -1, -1, ci, co, 100);
+        booking_tree = insert_booking(booking_tree, bookings[i]);
+        latencies[i] = now_ns() - t;
+    }
+    report_benchmark("insert_booking", records, latencies, records, now_ns() - start);
+
+    start = now_ns();
+    for (i = 0; i < lookups; i++)
+    {
+        snprintf(key, MAX_ID, "G%d", (int)(bench_random(&rng) % records));
+        t = now_ns();
+        if (find_guest(key) == NULL)
+            fprintf(stderr, "Benchmark error: guest %s missing\n", key);
+        latencies[i] = now_ns() - t;
+    }
+    report_benchmark("find_guest", records, latencies, lookups, now_ns() - start);
+
+    start = now_ns();
+    for (i = 0; i < lookups; i++)
+    {
+        strcpy(key, bookings[bench_random(&rng) % records]->booking_id);
+        t = now_ns();
+        if (find_booking(key) == NULL)
+            fprintf(stderr, "Benchmark error: booking %s missing\n", key);
+        latencies[i] = now_ns() - t;
+    }
+    report_benchmark("find_booking", records, latencies, lookups, now_ns() - start);
+
+    BillOp bill;
+    OpResult result;
+    bill.date = make_date(1, 1, BENCH_YEAR);
+    start = now_ns();
+    for (i = 0; i < lookups; i++)
+    {
+        BookingNode *booking = bookings[bench_random(&rng) % records];
+        strcpy(bill.guest_id, booking->guest_id);
+        strcpy(bill.booking_id, booking->booking_id);
+        t = now_ns();
+        if (apply_generate_bill(&bill, &result) != ST_OK)
+            fprintf(stderr, "Benchmark error: bill for %s failed\n", bill.booking_id);
+        latencies[i] = now_ns() - t;
+    }
+    report_benchmark("generate_bill", records, latencies, lookups, now_ns() - start);
+
+    free(latencies);
+    free(bookings);
+    release_records();
+    table_free(&bills);
+    booking_id_seq = 1;
+    return 1;
+}
+
+// ======================== CORE SYSTEM FUNCTIONS ========================
+
+// Default users and sample inventory for a fresh installation
+void seed_defaults()
+{
+    int i;
+    // Initialize users
+    strcpy(users[0].id, "admin");
+    strcpy(users[0].name, "Administrator");
+    strcpy(users[0].pass, "admin123");
+    strcpy(users[0].role, "admin");
+    strcpy(users[0].department, "Management");
+    users[0].access_level = 5;
+    user_count = 1;
+
+    // Initialize sample inventory
+    char *inv_names[] = {"Towels", "Bed Sheets", "Shampoo", "Coffee", "Light Bulbs"};
+    char *inv_cats[] = {"Housekeeping", "Housekeeping", "Housekeeping", "Food", "Maintenance"};
+    float inv_prices[] = {5.0, 10.0, 2.0, 3.0, 4.0};
+    int inv_quants[] = {100, 50, 200, 300, 150};
+    int inv_reorder[] = {20, 10, 50, 50, 30};
+    for (i = 0; i < 5; i++)
+    {
+        InventoryItem *item = (InventoryItem *)table_push(&inventory);
+        item->item_id = inventory.count;
+        strcpy(item->name, inv_names[i]);
+        strcpy(item->category, inv_cats[i]);
+        item->quantity = inv_quants[i];
+        item->unit_price = inv_prices[i];
+        item->reorder_level = inv_reorder[i];
+    }
+}
+
+// Load or seed state and open the log; returns 0 if the system cannot start safely
+int init_system()
+{
+    srand(time(0));
+    start_log_writer();
+    int i;
+    // Initialize rooms
+    for (i = 0; i < MAX_ROOMS; i++)
+    {
+        rooms.type[i] = (i % 3) + 1;
+        rooms.status[i] = 0;
+        atomic_init(&room_versions[i], 0);
+        rooms.floor[i] = (i / 10) + 1;
+        rooms.capacity[i] = (rooms.type[i] == 1) ? 2 : (rooms.type[i] == 2) ? 4
+                                                                            : 6;
+        if (rooms.type[i] == 1)
+        {
+            rooms.price[i] = 100 + (rand() % 50);
+            set_room_features(i + 1, "TV, WiFi, AC");
+        }
+        else if (rooms.type[i] == 2)
+        {
+            rooms.price[i] = 200 + (rand() % 100);
+            set_room_features(i + 1, "TV, WiFi, AC, Mini-bar, Balcony");
+        }
+        else
+        {
+            rooms.price[i] = 500 + (rand() % 200);
+            set_room_features(i + 1, "TV, WiFi, AC, Mini-bar, Jacuzzi, Living area");
+        }
+    }
+
+    // Initialize parking
+    for (i = MAX_PARKING; i >= 1; i--)
+    {
+        add_parking_slot(&parking_slots, i);
+    }
+
+    // Initialize facilities
+    init_facility_graph(FACILITY_FILE);
+    int loaded = load_snapshot(SNAPSHOT_FILE);
+    if (loaded < 0)
+    {
+        // Seeding over it would lose every record it and the log hold
+        fprintf(stderr, "Cannot use %s: unreadable or from another version; move it aside to start fresh\n",
+                SNAPSHOT_FILE);
+        return 0;
+    }
+    if (loaded == 0)
+    {
+        seed_defaults();
+        // Log records are only meaningful on top of a snapshot, so start from a baseline
+        if (!save_snapshot(SNAPSHOT_FILE))
+            printf("Warning: could not save %s\n", SNAPSHOT_FILE);
+        else
+            unlink(WAL_FILE);
+    }
+    return open_wal(WAL_FILE);
+}
+
+void add_guest(char *user_id)
+{
+    Operation op = {.type = OP_ADD_GUEST};
+    GuestOp *guest = &op.data.guest;
+    printf("Enter guest ID: ");
+    scanf("%s", guest->id);
+    if (find_guest(guest->id) != NULL)
+    {
+        printf("Guest ID exists!\n");
+        return;
+    }
+    printf("Enter name: ");
+    scanf(" %[^\n]", guest->name);
+    printf("Enter contact: ");
+    scanf("%s", guest->contact);
+    printf("Enter email: ");
+    scanf("%s", guest->email);
+    printf("Enter preferences (optional): ");
+    scanf(" %[^\n]", guest->preferences);
+    if (op_failed(execute_operation(user_id, &op, NULL)))
+        return;
+    printf("Guest added successfully!\n");
+}
+
+void view_guest_details()
+{
+    char id[MAX_ID];
+    printf("Enter guest ID: ");
+    scanf("%s", id);
+    Guest *guest = find_guest(id);
+    if (guest == NULL)
+    {
+        printf("Guest not found!\n");
+        return;
+    }
+    printf("\n=== GUEST DETAILS ===\n");
+    printf("ID: %s\nName: %s\nContact: %s\nEmail: %s\n",
+           guest->id, guest->name, guest->contact, guest->email);
+    printf("Preferences: %s\nLoyalty Points: %d\n",
+           guest->preferences, guest->loyalty_points);
+    printf("\nBooking History:\n");
+    search_bookings_by_guest(guest);
+}
+
+void book_room(char *user_id)
+{
+    if (guest_count == 0)
+    {
+        printf("No guests registered!\n");
+        return;
+    }
+    Operation op = {.type = OP_BOOK_ROOM};
+    BookingOp *request = &op.data.booking;
+    printf("Enter guest ID: ");
+    scanf("%s", request->guest_id);
+    Guest *guest = find_guest(request->guest_id);
+    if (guest == NULL)
+    {
+        printf("Guest not found!\n");
+        return;
+    }
+    Date ci, co;
+    printf("Enter check-in date (dd mm yyyy): ");
+    ci = read_date();
+    printf("Enter check-out date (dd mm yyyy): ");
+    co = read_date();
+    if (!is_valid_date(ci) || !is_valid_date(co) || date_diff(ci, co) <= 0)
+    {
+        printf("Invalid dates!\n");
+        return;
+    }
+    unsigned long long free_rooms[ROOM_WORDS];
+    find_free_rooms(ci, co, free_rooms);
+    printf("\nAvailable Rooms:\n");
+    print_rooms(free_rooms);
+    printf("\nEnter room number: ");
+    scanf("%d", &request->room_no);
+    if (request->room_no < 1 || request->room_no > MAX_ROOMS ||
+        !check_room_availability(request->room_no, ci, co, &op.room_version))
+    {
+        printf("Invalid or unavailable room!\n");
+        return;
+    }
+    request->facility_id = -1;
+    request->check_in = ci;
+    request->check_out = co;
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    if (result.amount > 0)
+        printf("Applied 10%% discount ($%.2f)!\n", result.amount);
+    char ci_text[DATE_TEXT], co_text[DATE_TEXT];
+    printf("\n=== BOOKING CONFIRMED ===\n");
+    printf("Booking ID: %s\nRoom: %d\nCheck-in: %s\nCheck-out: %s\nTotal: $%.2f\n",
+           result.booking->booking_id, request->room_no, format_date(ci, ci_text),
+           format_date(co, co_text), result.booking->total);
+    printf("Earned %d loyalty points. Total: %d\n", result.points, guest->loyalty_points);
+}
+
+void assign_parking(char *user_id)
+{
+    Operation op = {.type = OP_ASSIGN_PARKING};
+    ParkingOp *request = &op.data.parking;
+    printf("Enter guest ID: ");
+    scanf("%s", request->guest_id);
+    ParkingSlot *slot = find_guest_parking(request->guest_id);
+    if (slot != NULL)
+    {
+        printf("Guest already has slot %d!\n", slot->slot_no);
+        return;
+    }
+    printf("Enter vehicle type: ");
+    scanf(" %[^\n]", request->vehicle);
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    if (result.id != -1)
+        printf("Assigned slot %d for %s\n", result.id, request->vehicle);
+    else
+        printf("No parking available. Added to waitlist.\n");
+}
+
+void process_waitlist(char *user_id)
+{
+    int i;
+    int first = waitlist_head;
+    Operation op = {.type = OP_PROCESS_WAITLIST};
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    for (i = 0; i < result.count; i++)
+    {
+        WaitlistEntry *placed = &parking_waitlist[(first + i) % MAX_WAITLIST];
+        printf("Assigned slot %d to %s\n", find_guest_parking(placed->guest_id)->slot_no,
+               placed->vehicle);
+    }
+    if (result.count == 0)
+        printf("No parking slots free.\n");
+}
+
+void book_facility(char *user_id)
+{
+    int i, minutes;
+    char time_text[10], from[SLOT_TEXT], to[SLOT_TEXT];
+    Operation op = {.type = OP_BOOK_FACILITY};
+    BookingOp *request = &op.data.booking;
+    printf("\nEnter guest ID: ");
+    scanf("%s", request->guest_id);
+    Guest *guest = find_guest(request->guest_id);
+    if (guest == NULL)
+    {
+        printf("Guest not found!\n");
+        return;
+    }
+    printf("Enter booking date (dd mm yyyy): ");
+    Date date = read_date();
+    if (!is_valid_date(date))
+    {
+        printf("Invalid date!\n");
+        return;
+    }
+    printf("Enter start time (HH:MM): ");
+    scanf("%9s", time_text);
+    printf("Enter duration in minutes: ");
+    scanf("%d", &minutes);
+    request->room_no = -1;
+    request->check_in = request->check_out = date;
+    request->slot = parse_slot_time(time_text);
+    request->slots = slots_for_minutes(minutes);
+    if (!valid_slot_range(request->slot, request->slots))
+    {
+        printf("Invalid time slot!\n");
+        return;
+    }
+
+    printf("\nFacilities from %s to %s:\n", format_slot(request->slot, from),
+           format_slot(request->slot + request->slots, to));
+    printf("ID\tName\t\tFee\tCapacity\tStatus\n");
+    for (i = 0; i < facility_count; i++)
+    {
+        printf("%d\t%s\t$%.2f\t%d\t\t%s\n", facilities[i].facility_id, facilities[i].name,
+               facilities[i].booking_fee, facilities[i].capacity,
+               slots_free(i, date, request->slot, request->slots) ? "Available" : "Full");
+    }
+    printf("\nEnter facility ID (0 to find the nearest by type): ");
+    scanf("%d", &request->facility_id);
+    if (request->facility_id == 0)
+    {
+        int room_no;
+        char kinds[100];
+        printf("Enter room number: ");
+        scanf("%d", &room_no);
+        printf("Enter facility types (e.g. spa, pool): ");
+        scanf(" %99[^\n]", kinds);
+        FacilityDistance *nearest = room_no >= 1 && room_no <= MAX_ROOMS
+                                        ? nearest_facility(room_node(room_no), kinds, date,
+                                                           request->slot, request->slots)
+                                        : NULL;
+        if (nearest == NULL)
+        {
+            printf("No available facility of that type!\n");
+            return;
+        }
+        request->facility_id = nearest->facility + 1;
+        printf("Nearest: %s, %.0f m from room %d\n", facilities[nearest->facility].name,
+               nearest->metres, room_no);
+    }
+    OpResult result;
+    OpStatus status = execute_operation(user_id, &op, &result);
+    if (op_failed(status))
+    {
+        if (status == ST_FACILITY_UNAVAILABLE)
+            print_free_slots(request->facility_id - 1, date, FREE_SLOTS_DAYS);
+        return;
+    }
+    if (result.amount > 0)
+        printf("Applied 50%% discount! New fee: $%.2f\n", result.amount);
+    printf("\n=== FACILITY BOOKING CONFIRMED ===\n");
+    char date_text[DATE_TEXT];
+    printf("Booking ID: %s\nFacility: %s\nDate: %s\nTime: %s-%s\nFee: $%.2f\n",
+           result.booking->booking_id, facilities[request->facility_id - 1].name,
+           format_date(date, date_text), from, to, result.booking->total);
+    printf("Earned %d loyalty points. Total: %d\n", result.points, guest->loyalty_points);
+    find_nearby_facilities(request->facility_id);
+}
+
+void order_room_service(char *user_id)
+{
+    Operation op = {.type = OP_ORDER_SERVICE};
+    ServiceOrderOp *order = &op.data.service;
+    printf("Enter room number: ");
+    scanf("%d", &order->room_no);
+    if (order->room_no < 1 || order->room_no > MAX_ROOMS)
+    {
+        printf("Invalid room number!\n");
+        return;
+    }
+    if (room_occupant[order->room_no - 1] == NULL)
+    {
+        printf("Room not occupied!\n");
+        return;
+    }
+    printf("Available items:\n");
+    printf("1. Breakfast Set ($15.00)\n2. Lunch Set ($20.00)\n3. Dinner Set ($25.00)\n");
+    printf("4. Snack Pack ($10.00)\n5. Beverage ($5.00)\n");
+    printf("Enter item number: ");
+    scanf("%d", &order->item);
+    get_current_time(order->time);
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    printf("\n=== SERVICE ORDER CREATED ===\n");
+    printf("Order ID: %d\nRoom: %d\nItems: %s\nTime: %s\nCharge: $%.2f\n",
+           result.id, order->room_no, service_items[order->item - 1], order->time,
+           service_prices[order->item - 1]);
+}
+
+void update_service_status(char *user_id)
+{
+    int i;
+    if (services.count == 0)
+    {
+        printf("No service orders!\n");
+        return;
+    }
+    printf("Current service orders:\n");
+    printf("ID\tRoom\tItems\t\tTime\tStatus\tCharge\n");
+    for (i = 0; i < services.count; i++)
+    {
+        RoomService *service = (RoomService *)table_at(&services, i);
+        printf("%d\t%d\t%s\t%s\t%s\t$%.2f\n",
+               service->service_id, service->room_no, service->items,
+               service->time, service->status, service->charge);
+    }
+    Operation op = {.type = OP_UPDATE_SERVICE};
+    StatusOp *update = &op.data.status;
+    printf("Enter service ID: ");
+    scanf("%d", &update->id);
+    RoomService *service = (RoomService *)table_find(&services, update->id);
+    if (service == NULL)
+    {
+        printf("Service ID not found!\n");
+        return;
+    }
+    if (strcmp(service->status, "Completed") == 0)
+    {
+        printf("Order already completed!\n");
+        return;
+    }
+    printf("\nCurrent status: %s\n1. Mark as In Progress\n2. Mark as Completed\n",
+           service->status);
+    printf("Enter choice: ");
+    scanf("%d", &update->choice);
+    if (op_failed(execute_operation(user_id, &op, NULL)))
+        return;
+    if (update->choice == 1)
+        printf("Status updated to In Progress\n");
+    else
+        printf("Status updated to Completed. Guest earned 1 point.\n");
+}
+
+void report_maintenance(char *user_id)
+{
+    Operation op = {.type = OP_REPORT_MAINTENANCE};
+    MaintenanceOp *report = &op.data.maintenance;
+    printf("Enter room number: ");
+    scanf("%d", &report->room_no);
+    if (report->room_no < 1 || report->room_no > MAX_ROOMS)
+    {
+        printf("Invalid room number!\n");
+        return;
+    }
+    printf("Issue types:\n1. Electrical\n2. Plumbing\n3. HVAC\n4. Furniture\n5. Other\n");
+    printf("Enter issue type: ");
+    scanf("%d", &report->issue_type);
+    if (report->issue_type < 1 || report->issue_type > 5)
+    {
+        printf("Invalid issue type!\n");
+        return;
+    }
+    printf("Priority:\n1. Low\n2. Medium\n3. High\n");
+    printf("Enter priority: ");
+    scanf("%d", &report->priority);
+    if (report->priority < 1 || report->priority > 3)
+    {
+        printf("Invalid priority!\n");
+        return;
+    }
+    printf("Enter description: ");
+    scanf(" %[^\n]", report->description);
+    report->date = get_current_date();
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    MaintenanceRequest *request = (MaintenanceRequest *)table_find(&maintenance, result.id);
+    char date_text[DATE_TEXT];
+    printf("\n=== MAINTENANCE REQUEST CREATED ===\n");
+    printf("Request ID: %d\nRoom: %d\nIssue: %s\nPriority: %s\nDate: %s\n",
+           request->request_id, request->room_no, request->issue, request->priority,
+           format_date(request->report_date, date_text));
+}
+
+void update_maintenance_status(char *user_id)
+{
+    int i;
+    char date_text[DATE_TEXT];
+    if (maintenance.count == 0)
+    {
+        printf("No maintenance requests!\n");
+        return;
+    }
+    printf("Maintenance Requests:\n");
+    printf("ID\tRoom\tIssue\tPriority\tStatus\tDate\n");
+    for (i = 0; i < maintenance.count; i++)
+    {
+        MaintenanceRequest *request = (MaintenanceRequest *)table_at(&maintenance, i);
+        printf("%d\t%d\t%s\t%s\t%s\t%s\n",
+               request->request_id, request->room_no, request->issue,
+               request->priority, request->status, format_date(request->report_date, date_text));
+    }
+    Operation op = {.type = OP_UPDATE_MAINTENANCE};
+    StatusOp *update = &op.data.status;
+    printf("Enter request ID: ");
+    scanf("%d", &update->id);
+    MaintenanceRequest *request = (MaintenanceRequest *)table_find(&maintenance, update->id);
+    if (request == NULL)
+    {
+        printf("Request ID not found!\n");
+        return;
+    }
+    if (strcmp(request->status, "Resolved") == 0)
+    {
+        printf("Request already resolved!\n");
+        return;
+    }
+    printf("\nCurrent status: %s\n1. Mark as In Progress\n2. Mark as Resolved\n",
+           request->status);
+    printf("Enter choice: ");
+    scanf("%d", &update->choice);
+    if (op_failed(execute_operation(user_id, &op, NULL)))
+        return;
+    if (update->choice == 1)
+        printf("Status updated to In Progress\n");
+    else
+        printf("Status updated to Resolved. Room available.\n");
+}
+
+void submit_feedback(char *user_id)
+{
+    Operation op = {.type = OP_SUBMIT_FEEDBACK};
+    FeedbackOp *feedback = &op.data.feedback;
+    printf("Enter guest ID: ");
+    scanf("%s", feedback->guest_id);
+    if (find_guest(feedback->guest_id) == NULL)
+    {
+        printf("Guest not found!\n");
+        return;
+    }
+    printf("Enter comment: ");
+    scanf(" %[^\n]", feedback->comment);
+    printf("Enter rating (1-5): ");
+    scanf("%d", &feedback->rating);
+    feedback->date = get_current_date();
+    if (op_failed(execute_operation(user_id, &op, NULL)))
+        return;
+    printf("Feedback submitted successfully!\n");
+}
+
+void manage_inventory(char *user_id)
+{
+    int choice;
+    int i;
+    do
+    {
+        printf("\n=== INVENTORY MANAGEMENT ===\n");
+        printf("1. View Inventory\n2. Add Item\n3. Update Quantity\n4. Check Low Stock\n5. Exit\n");
+        printf("Enter choice: ");
+        scanf("%d", &choice);
+        switch (choice)
+        {
+        case 1:
+            printf("Inventory:\n");
+            printf("ID\tName\tCategory\tQuantity\tPrice\tReorder Level\n");
+            for (i = 0; i < inventory.count; i++)
+            {
+                InventoryItem *item = (InventoryItem *)table_at(&inventory, i);
+                printf("%d\t%s\t%s\t%d\t$%.2f\t%d\n",
+                       item->item_id, item->name, item->category,
+                       item->quantity, item->unit_price, item->reorder_level);
+            }
+            break;
+        case 2:
+        {
+            Operation op = {.type = OP_ADD_ITEM};
+            ItemOp *item = &op.data.item;
+            printf("Enter item name: ");
+            scanf(" %[^\n]", item->name);
+            printf("Enter category: ");
+            scanf(" %[^\n]", item->category);
+            printf("Enter quantity: ");
+            scanf("%d", &item->quantity);
+            printf("Enter unit price: ");
+            scanf("%f", &item->unit_price);
+            printf("Enter reorder level: ");
+            scanf("%d", &item->reorder_level);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Item added!\n");
+            break;
+        }
+        case 3:
+        {
+            Operation op = {.type = OP_UPDATE_QUANTITY};
+            printf("Enter item ID: ");
+            scanf("%d", &op.data.quantity.id);
+            if (table_find(&inventory, op.data.quantity.id) == NULL)
+            {
+                printf("Item not found!\n");
+                break;
+            }
+            printf("Enter new quantity: ");
+            scanf("%d", &op.data.quantity.quantity);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Quantity updated!\n");
+            break;
+        }
+        case 4:
+            printf("Low Stock Items:\n");
+            for (i = 0; i < inventory.count; i++)
+            {
+                InventoryItem *item = (InventoryItem *)table_at(&inventory, i);
+                if (item->quantity <= item->reorder_level)
+                {
+                    printf("%d\t%s\t%d (Reorder at %d)\n",
+                           item->item_id, item->name, item->quantity, item->reorder_level);
+                }
+            }
+            break;
+        case 5:
+            break;
+        default:
+            printf("Invalid choice!\n");
+        }
+    } while (choice != 5);
+}
+
+void manage_events(char *user_id)
+{
+    int choice;
+    int i;
+    char date_text[DATE_TEXT];
+    do
+    {
+        printf("\n=== EVENT MANAGEMENT ===\n");
+        printf("1. View Events\n2. Add Event\n3. Update Event Status\n4. Exit\n");
+        printf("Enter choice: ");
+        scanf("%d", &choice);
+        switch (choice)
+        {
+        case 1:
+            printf("Events:\n");
+            printf("ID\tName\tDate\tTime\tFacility\tStatus\n");
+            for (i = 0; i < events.count; i++)
+            {
+                Event *event = (Event *)table_at(&events, i);
+                char *status[] = {"Planned", "Ongoing", "Completed"};
+                printf("%d\t%s\t%s\t%s\t%s\t%s\n",
+                       event->event_id, event->name, format_date(event->date, date_text),
+                       event->time, facility_name(event->facility_id),
+                       status[event->status]);
+            }
+            break;
+        case 2:
+        {
+            Operation op = {.type = OP_ADD_EVENT};
+            EventOp *event = &op.data.event;
+            printf("Enter event name: ");
+            scanf(" %[^\n]", event->name);
+            printf("Enter date (dd mm yyyy): ");
+            event->date = read_date();
+            printf("Enter time (HH:MM): ");
+            scanf("%s", event->time);
+            printf("Enter facility ID: ");
+            scanf("%d", &event->facility_id);
+            printf("Enter organizer: ");
+            scanf(" %[^\n]", event->organizer);
+            printf("Enter capacity: ");
+            scanf("%d", &event->capacity);
+            printf("Enter cost: ");
+            scanf("%f", &event->cost);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Event added!\n");
+            break;
+        }
+        case 3:
+        {
+            Operation op = {.type = OP_UPDATE_EVENT};
+            printf("Enter event ID: ");
+            scanf("%d", &op.data.status.id);
+            Event *event = (Event *)table_find(&events, op.data.status.id);
+            if (event == NULL)
+            {
+                printf("Event not found!\n");
+                break;
+            }
+            printf("Current status: %s\n1. Mark as Ongoing\n2. Mark as Completed\n",
+                   event->status == 0 ? "Planned" : event->status == 1 ? "Ongoing"
+                                                                       : "Completed");
+            printf("Enter new status: ");
+            scanf("%d", &op.data.status.choice);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Status updated!\n");
+            break;
+        }
+        case 4:
+            break;
+        default:
+            printf("Invalid choice!\n");
+        }
+    } while (choice != 4);
+}
+
+void manage_staff_schedule(char *user_id)
+{
+    int choice;
+    int i;
+    char date_text[DATE_TEXT];
+    do
+    {
+        printf("\n=== STAFF SCHEDULING ===\n");
+        printf("1. View Schedules\n2. Add Schedule\n3. Update Schedule\n4. Exit\n");
+        printf("Enter choice: ");
+        scanf("%d", &choice);
+        switch (choice)
+        {
+        case 1:
+            printf("Schedules:\n");
+            printf("ID\tStaff ID\tDate\tShift\tTask\n");
+            for (i = 0; i < schedules.count; i++)
+            {
+                StaffSchedule *schedule = (StaffSchedule *)table_at(&schedules, i);
+                printf("%d\t%s\t%s\t%s\t%s\n",
+                       schedule->schedule_id, schedule->staff_id,
+                       format_date(schedule->date, date_text), schedule->shift, schedule->task);
+            }
+            break;
+        case 2:
+        {
+            Operation op = {.type = OP_ADD_SCHEDULE};
+            ScheduleOp *schedule = &op.data.schedule;
+            printf("Enter staff ID: ");
+            scanf("%s", schedule->staff_id);
+            int staff_found = 0;
+            for (i = 0; i < user_count; i++)
+            {
+                if (strcmp(users[i].id, schedule->staff_id) == 0)
+                {
+                    staff_found = 1;
+                    break;
+                }
+            }
+            if (!staff_found)
+            {
+                printf("Staff ID not found!\n");
+                break;
+            }
+            printf("Enter date (dd mm yyyy): ");
+            schedule->date = read_date();
+            printf("Enter shift (Morning/Evening/Night): ");
+            scanf("%s", schedule->shift);
+            printf("Enter task: ");
+            scanf(" %[^\n]", schedule->task);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Schedule added!\n");
+            break;
+        }
+        case 3:
+        {
+            Operation op = {.type = OP_UPDATE_SCHEDULE};
+            ScheduleOp *update = &op.data.schedule;
+            printf("Enter schedule ID: ");
+            scanf("%d", &update->id);
+            StaffSchedule *schedule = (StaffSchedule *)table_find(&schedules, update->id);
+            if (schedule == NULL)
+            {
+                printf("Schedule not found!\n");
+                break;
+            }
+            printf("Current Schedule: %s, %s, %s\n",
+                   schedule->staff_id, schedule->shift, format_date(schedule->date, date_text));
+            printf("Enter new shift: ");
+            scanf("%s", update->shift);
+            printf("Enter new task: ");
+            scanf(" %[^\n]", update->task);
+            if (!op_failed(execute_operation(user_id, &op, NULL)))
+                printf("Schedule updated!\n");
+            break;
+        }
+        case 4:
+            break;
+        default:
+            printf("Invalid choice!\n");
+        }
+    } while (choice != 4);
+}
+
+void generate_bill(char *user_id)
+{
+    Operation op = {.type = OP_GENERATE_BILL};
+    BillOp *request = &op.data.bill;
+    printf("Enter guest ID: ");
+    scanf("%s", request->guest_id);
+    if (find_guest(request->guest_id) == NULL)
+    {
+        printf("Guest not found!\n");
+        return;
+    }
+    printf("Enter booking ID: ");
+    scanf("%s", request->booking_id);
+    request->date = get_current_date();
+    OpResult result;
+    if (op_failed(execute_operation(user_id, &op, &result)))
+        return;
+    Bill *bill = (Bill *)table_find(&bills, result.id);
+    printf("\n=== BILL GENERATED ===\n");
+    printf("Bill ID: %d\nGuest: %s\nBooking ID: %s\n", bill->bill_id, bill->guest_id,
+           bill->booking_id);
+    printf("Room Charges: $%.2f\nService Charges: $%.2f\nFacility Charges: $%.2f\n",
+           bill->room_charges, bill->service_charges, bill->facility_charges);
+    printf("Taxes (10%%): $%.2f\nTotal: $%.2f\nStatus: Unpaid\n", bill->taxes, bill->total);
+}
+
+void process_payment(char *user_id)
+{
+    Operation op = {.type = OP_PROCESS_PAYMENT};
+    printf("Enter bill ID: ");
+    scanf("%d", &op.data.payment.id);
+    Bill *bill = (Bill *)table_find(&bills, op.data.payment.id);
+    if (bill == NULL)
+    {
+        printf("Bill not found!\n");
+        return;
+    }
+    if (bill->status == 1)
+    {
+        printf("Bill already paid!\n");
+        return;
+    }
+    printf("Bill Details:\nTotal: $%.2f\n", bill->total);
+    printf("1. Pay by Cash\n2. Pay by Card\n3. Cancel\n");
+    printf("Enter payment method: ");
+    scanf("%d", &op.data.payment.method);
+    if (op.data.payment.method != 1 && op.data.payment.method != 2)
+    {
+        printf("Payment cancelled.\n");
+        return;
+    }
+    op.data.payment.date = get_current_date();
+    if (op_failed(execute_operation(user_id, &op, NULL)))
+        return;
+    printf("Payment successful! Bill marked as paid.\n");
+}
+
+void search_rooms()
+{
+    int w;
+    Date ci, co;
+    RoomFilter filter;
+    printf("Enter check-in date (dd mm yyyy): ");
+    ci = read_date();
+    printf("Enter check-out date (dd mm yyyy): ");
+    co = read_date();
+    if (!is_valid_date(ci) || !is_valid_date(co) || date_diff(ci, co) <= 0)
+    {
+        printf("Invalid dates!\n");
+        return;
+    }
+    printf("Room type (0: Any, 1: Standard, 2: Deluxe, 3: Suite): ");
+    scanf("%d", &filter.type);
+    printf("Floor range (min max, 0 0 for any): ");
+    scanf("%d %d", &filter.floor_min, &filter.floor_max);
+    printf("Minimum capacity (0 for any): ");
+    scanf("%d", &filter.capacity_min);
+    printf("Maximum price per night (0 for any): ");
+    scanf("%f", &filter.price_max);
+    char list[200];
+    printf("Features:");
+    for (w = 0; w < rooms.feature_count; w++)
+        printf("%s %s", w ? "," : "", rooms.feature_names[w]);
+    printf("\nRequired features, comma-separated (- for none): ");
+    scanf(" %[^\n]", list);
+    if (strcmp(list, "-") == 0)
+        filter.features_all = 0;
+    else if (!parse_features(list, &filter.features_all, 0))
+        return;
+    printf("Any of these features, comma-separated (- for none): ");
+    scanf(" %[^\n]", list);
+    if (strcmp(list, "-") == 0)
+        filter.features_any = 0;
+    else if (!parse_features(list, &filter.features_any, 0))
+        return;
+    unsigned long long matches[ROOM_WORDS], free_rooms[ROOM_WORDS];
+    filter_rooms(&filter, matches);
+    find_free_rooms(ci, co, free_rooms);
+    for (w = 0; w < ROOM_WORDS; w++)
+        matches[w] &= free_rooms[w];
+    printf("\nMatching Rooms:\n");
+    printf("%d room(s) found.\n", print_rooms(matches));
+}
+
+void analytics_dashboard(char *user_id)
+{
+    printf("\n=== ANALYTICS DASHBOARD ===\n");
+    long occupied_rooms = metric_get(&metrics.rooms_occupied);
+    printf("Room Occupancy: %ld/%d (%.2f%%)\n", occupied_rooms, MAX_ROOMS,
+           (float)occupied_rooms / MAX_ROOMS * 100);
+    printf("Rooms Under Maintenance: %ld\n", metric_get(&metrics.rooms_in_maintenance));
+    long occupied_parking = metric_get(&metrics.parking_occupied);
+    printf("Parking Occupancy: %ld/%d (%.2f%%)\n", occupied_parking, MAX_PARKING,
+           (float)occupied_parking / MAX_PARKING * 100);
+    printf("Parking Waitlist: %u\n", waitlist_tail - waitlist_head);
+    long ratings = metric_get(&metrics.feedback_count);
+    float avg_rating = ratings > 0 ? (float)metric_get(&metrics.rating_sum) / ratings : 0;
+    printf("Average Guest Rating: %.2f/5 (%ld reviews)\n", avg_rating, ratings);
+    printf("Total Revenue: $%.2f\n", total_revenue);
+    printf("Open Maintenance Requests: %ld\n", metric_get(&metrics.maintenance_open));
+    printf("Pending Service Orders: %ld\n", metric_get(&metrics.services_pending));
+    printf("Bookings: %ld active, %ld upcoming, %ld completed\n",
+           metric_get(&metrics.bookings_active), metric_get(&metrics.bookings_upcoming),
+           metric_get(&metrics.bookings_completed));
+    printf("\nAllocator statistics:\n");
+    pool_report(&guest_pool);
+    pool_report(&booking_pool);
+    pool_report(&parking_pool);
+    char log_msg[100];
+    sprintf(log_msg, "Viewed analytics dashboard");
+    log_activity(user_id, log_msg);
+}
+
+void revenue_reports(char *user_id)
+{
+    int choice;
+    DateParts period = {0, 0, 0};
+    printf("\n=== REVENUE REPORTS ===\n");
+    printf("1. Daily Report\n2. Monthly Report\n3. Yearly Report\n");
+    printf("Enter choice: ");
+    scanf("%d", &choice);
+    if (choice == 1)
+    {
+        printf("Enter date (dd mm yyyy): ");
+        scanf("%d %d %d", &period.day, &period.month, &period.year);
+    }
+    else if (choice == 2)
+    {
+        printf("Enter month (mm yyyy): ");
+        scanf("%d %d", &period.month, &period.year);
+    }
+    else if (choice == 3)
+    {
+        printf("Enter year (yyyy): ");
+        scanf("%d", &period.year);
+    }
+    else
+    {
+        printf("Invalid choice!\n");
+        return;
+    }
+    if (!is_valid_date(make_date(period.day ? period.day : 1, period.month ? period.month : 1, period.year)))
+    {
+        printf("Invalid date!\n");
+        return;
+    }
+    if (choice == 1)
+        printf("\nReport for %02d/%02d/%d\n", period.day, period.month, period.year);
+    else if (choice == 2)
+        printf("\nReport for %02d/%d\n", period.month, period.year);
+    else
+        printf("\nReport for %d\n", period.year);
+    print_rollup_report(period);
+    log_activity(user_id, "Viewed revenue report");
+}
+
+void view_logs(char *user_id)
+{
+    int i;
+    char date_text[DATE_TEXT];
+    log_flush();
+    pthread_mutex_lock(&logs_lock);
+    if (logs.count == 0)
+    {
+        pthread_mutex_unlock(&logs_lock);
+        printf("No logs available!\n");
+        return;
+    }
+    printf("\n=== SYSTEM LOGS ===\n");
+    printf("ID\tUser\tAction\tDate\tTime\n");
+    for (i = 0; i < logs.count; i++)
+    {
+        SystemLog *log = (SystemLog *)table_at(&logs, i);
+        printf("%d\t%s\t%s\t%s\t%s\n",
+               log->log_id, log->user_id, log->action, format_date(log->date, date_text), log->time);
+    }
+    pthread_mutex_unlock(&logs_lock);
+    char log_msg[100];
+    sprintf(log_msg, "Viewed system logs");
+    log_activity(user_id, log_msg);
+}
+
+void login()
+{
+    int i;
+    char id[MAX_ID], pass[MAX_PASS];
+    printf("Enter ID: ");
+    scanf("%s", id);
+    printf("Enter password: ");
+    scanf("%s", pass);
+    int access_level = 0;
+    char user_id[MAX_ID];
+    for (i = 0; i < user_count; i++)
+    {
+        if (strcmp(users[i].id, id) == 0 && strcmp(users[i].pass, pass) == 0)
+        {
+            access_level = users[i].access_level;
+            strcpy(user_id, users[i].id);
+            break;
+        }
+    }
+    if (access_level == 0)
+    {
+        printf("Invalid credentials!\n");
+        return;
+    }
+    printf("Login successful! Access level: %d\n", access_level);
+    int choice;
+    do
+    {
+        advance_clock(get_current_date());
+        printf("\n=== HOTEL MANAGEMENT SYSTEM ===\n");
+        printf("1. Add Guest\n2. View Guest Details\n3. Book Room\n4. Assign Parking\n");
+        printf("5. Process Parking Waitlist\n6. Book Facility\n7. Order Room Service\n");
+        printf("8. Update Service Status\n9. Report Maintenance\n10. Update Maintenance Status\n");
+        printf("11. Submit Feedback\n12. Manage Inventory\n13. Manage Events\n");
+        printf("14. Manage Staff Schedule\n15. Generate Bill\n16. Process Payment\n");
+        printf("17. Analytics Dashboard\n18. Revenue Reports\n19. Search Rooms\n");
+        if (access_level >= 5)
+            printf("20. View System Logs\n21. Exit\n");
+        else
+            printf("20. Exit\n");
+        printf("Enter choice: ");
+        scanf("%d", &choice);
+        switch (choice)
+        {
+        case 1:
+            add_guest(user_id);
+            break;
+        case 2:
+            view_guest_details();
+            break;
+        case 3:
+            book_room(user_id);
+            break;
+        case 4:
+            assign_parking(user_id);
+            break;
+        case 5:
+            process_waitlist(user_id);
+            break;
+        case 6:
+            book_facility(user_id);
+            break;
+        case 7:
+            order_room_service(user_id);
+            break;
+        case 8:
+            update_service_status(user_id);
+            break;
+        case 9:
+            report_maintenance(user_id);
+            break;
+        case 10:
+            update_maintenance_status(user_id);
+            break;
+        case 11:
+            submit_feedback(user_id);
+            break;
+        case 12:
+            manage_inventory(user_id);
+            break;
+        case 13:
+            manage_events(user_id);
+            break;
+        case 14:
+            manage_staff_schedule(user_id);
+            break;
+        case 15:
+            generate_bill(user_id);
+            break;
+        case 16:
+            process_payment(user_id);
+            break;
+        case 17:
+            analytics_dashboard(user_id);
+            break;
+        case 18:
+            revenue_reports(user_id);
+            break;
+        case 19:
+            search_rooms();
+            break;
+        case 20:
+            if (access_level >= 5)
+                view_logs(user_id);
+            else
+                choice = 21;
+            break;
+        case 21:
+            if (access_level >= 5)
+                break;
+            else
+                printf("Invalid choice!\n");
+            break;
+        default:
+            printf("Invalid choice!\n");
+        }
+    } while (choice != (access_level >= 5 ? 21 : 20));
+}
+
+int main(int argc, char *argv[])
+{
+    int i, exit_status = 0;
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        long default_sizes[] = {1000, 100000, 10000000};
+        if (argc == 2)
+        {
+            for (i = 0; i < 3; i++)
+            {
+                if (!run_benchmarks(default_sizes[i]))
+                    return 1;
+            }
+        }
+        for (i = 2; i < argc; i++)
+        {
+            if (atol(argv[i]) > 0 && !run_benchmarks(atol(argv[i])))
+                return 1;
+        }
+        return 0;
+    }
+    int serve = argc > 1 && strcmp(argv[1], "--serve") == 0;
+    if (argc > 1 && strcmp(argv[1], "--batch") != 0 && !serve)
+    {
+        printf("Usage: %s [--batch [file] | --serve [socket] | --bench [records...]]\n", argv[0]);
+        return 1;
+    }
+    FILE *batch_input = stdin;
+    if (argc > 2 && !serve && (batch_input = fopen(argv[2], "r")) == NULL)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    if (!init_system())
+    {
+        stop_log_writer();
+        return 1;
+    }
+    if (serve)
+    {
+        run_server(argc > 2 ? argv[2] : SERVER_SOCKET);
+    }
+    else if (argc > 1)
+    {
+        exit_status = run_batch(batch_input, "batch") ? 0 : 1;
+        if (batch_input != stdin)
+            fclose(batch_input);
+    }
+    else
+    {
+        printf("Welcome to Hotel Management System\n");
+        login();
+    }
+    stop_log_writer();
+    close_wal();
+    // After a log failure memory holds changes that were reported as failed; keep the durable state
+    if (wal_failed())
+        fprintf(stderr, "%s not saved: %s\n", SNAPSHOT_FILE, status_messages[ST_IO_ERROR]);
+    else if (!checkpoint())
+        printf("Warning: could not save %s\n", SNAPSHOT_FILE);
+    if (wal_fd >= 0)
+        close(wal_fd);
+    release_records();
+    return exit_status;
 }
\ No newline at end of file